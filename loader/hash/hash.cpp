@@ -8,50 +8,207 @@
 #include <ciso646>
 #include "picosha2.h"
 #include <vector>
+#include <algorithm>
+#include <cstring>
 
 template <class Func>
-void readBuffered(std::ifstream& stream, Func func) {
-    constexpr size_t BUF_SIZE = 4096;
+geode::Result<> readBuffered(ghc::filesystem::path const& path, Func func) {
+    // large reads keep the hashers busy instead of the stream
+    constexpr size_t BUF_SIZE = 1024 * 1024;
+
+    std::ifstream stream(path, std::ios::binary);
+    if (!stream) {
+        return geode::Err("Unable to open {}", path.string());
+    }
     stream.exceptions(std::ios_base::badbit);
-    
-    std::vector<uint8_t> buffer(BUF_SIZE);
-    while (true) {
-        stream.read(reinterpret_cast<char*>(buffer.data()), BUF_SIZE);
-        size_t amt = stream ? BUF_SIZE : stream.gcount();
-        func(buffer.data(), amt);
-        if (!stream) break;
+
+    try {
+        std::vector<uint8_t> buffer(BUF_SIZE);
+        while (true) {
+            stream.read(reinterpret_cast<char*>(buffer.data()), BUF_SIZE);
+            size_t amt = stream ? BUF_SIZE : stream.gcount();
+            func(buffer.data(), amt);
+            if (!stream) break;
+        }
     }
+    catch (std::ios_base::failure const& e) {
+        return geode::Err("Unable to read {}: {}", path.string(), e.what());
+    }
+    return geode::Ok();
 }
 
-std::string calculateSHA3_256(ghc::filesystem::path const& path) {
-    std::ifstream file(path, std::ios::binary);
+geode::Result<std::string> calculateSHA3_256(ghc::filesystem::path const& path) {
     SHA3 sha;
-    readBuffered(file, [&](const void* data, size_t amt) {
+    GEODE_UNWRAP(readBuffered(path, [&](const void* data, size_t amt) {
         sha.add(data, amt);
-    });
-    return sha.getHash();
+    }));
+    return geode::Ok(sha.getHash());
 }
 
-std::string calculateSHA256(ghc::filesystem::path const& path) {
-    std::vector<uint8_t> hash(picosha2::k_digest_size);
-    std::ifstream file(path, std::ios::binary);
-    picosha2::hash256(file, hash.begin(), hash.end());
-    return picosha2::bytes_to_hex_string(hash.begin(), hash.end());
+geode::Result<std::string> calculateSHA256(ghc::filesystem::path const& path) {
+    picosha2::hash256_one_by_one hasher;
+    GEODE_UNWRAP(readBuffered(path, [&](const uint8_t* data, size_t amt) {
+        hasher.process(data, data + amt);
+    }));
+    hasher.finish();
+    return geode::Ok(picosha2::get_hash_hex_string(hasher));
 }
 
-std::string calculateSHA256Text(ghc::filesystem::path const& path) {
-    // remove all newlines
-    std::vector<uint8_t> hash(picosha2::k_digest_size);
-    std::ifstream file(path);
-    std::string text;
-    std::string line;
-    while (std::getline(file, line)) {
-        text += line;
+geode::Result<std::string> calculateSHA256Text(ghc::filesystem::path const& path) {
+    // remove all newlines; this must match reading the file line by line in 
+    // text mode, which on Windows also turns \r\n into \n
+    picosha2::hash256_one_by_one hasher;
+    std::vector<uint8_t> text;
+    bool pendingCR = false;
+    GEODE_UNWRAP(readBuffered(path, [&](const uint8_t* data, size_t amt) {
+        text.clear();
+        text.reserve(amt + 1);
+        for (size_t i = 0; i < amt; i++) {
+#ifdef _WIN32
+            if (pendingCR) {
+                pendingCR = false;
+                if (data[i] != '\n') {
+                    text.push_back('\r');
+                }
+            }
+            if (data[i] == '\r') {
+                pendingCR = true;
+                continue;
+            }
+#endif
+            if (data[i] != '\n') {
+                text.push_back(data[i]);
+            }
+        }
+        hasher.process(text.begin(), text.end());
+    }));
+    if (pendingCR) {
+        uint8_t cr = '\r';
+        hasher.process(&cr, &cr + 1);
     }
-    picosha2::hash256(text.begin(), text.end(), hash.begin(), hash.end());
-    return picosha2::bytes_to_hex_string(hash.begin(), hash.end());
+    hasher.finish();
+    return geode::Ok(picosha2::get_hash_hex_string(hasher));
 }
 
-std::string calculateHash(ghc::filesystem::path const& path) {
+geode::Result<std::string> calculateHash(ghc::filesystem::path const& path) {
     return calculateSHA3_256(path);
-}
\ No newline at end of file
+}
+
+namespace {
+    // Minimal SHA-1, only used for git object IDs
+    class SHA1 {
+        uint32_t m_state[5] = { 0x67452301, 0xefcdab89, 0x98badcfe, 0x10325476, 0xc3d2e1f0 };
+        uint8_t m_block[64];
+        size_t m_blockSize = 0;
+        uint64_t m_size = 0;
+
+        static uint32_t rotl(uint32_t value, int bits) {
+            return (value << bits) | (value >> (32 - bits));
+        }
+
+        void processBlock() {
+            uint32_t w[80];
+            for (int i = 0; i < 16; i++) {
+                w[i] = uint32_t(m_block[i * 4]) << 24 | uint32_t(m_block[i * 4 + 1]) << 16 |
+                    uint32_t(m_block[i * 4 + 2]) << 8 | uint32_t(m_block[i * 4 + 3]);
+            }
+            for (int i = 16; i < 80; i++) {
+                w[i] = rotl(w[i - 3] ^ w[i - 8] ^ w[i - 14] ^ w[i - 16], 1);
+            }
+            uint32_t a = m_state[0], b = m_state[1], c = m_state[2], d = m_state[3], e = m_state[4];
+            for (int i = 0; i < 80; i++) {
+                uint32_t f, k;
+                if (i < 20) {
+                    f = (b & c) | (~b & d);
+                    k = 0x5a827999;
+                }
+                else if (i < 40) {
+                    f = b ^ c ^ d;
+                    k = 0x6ed9eba1;
+                }
+                else if (i < 60) {
+                    f = (b & c) | (b & d) | (c & d);
+                    k = 0x8f1bbcdc;
+                }
+                else {
+                    f = b ^ c ^ d;
+                    k = 0xca62c1d6;
+                }
+                uint32_t temp = rotl(a, 5) + f + e + k + w[i];
+                e = d;
+                d = c;
+                c = rotl(b, 30);
+                b = a;
+                a = temp;
+            }
+            m_state[0] += a;
+            m_state[1] += b;
+            m_state[2] += c;
+            m_state[3] += d;
+            m_state[4] += e;
+        }
+
+    public:
+        void add(void const* data, size_t size) {
+            auto bytes = static_cast<uint8_t const*>(data);
+            m_size += size;
+            while (size > 0) {
+                auto amt = std::min(size, sizeof(m_block) - m_blockSize);
+                std::memcpy(m_block + m_blockSize, bytes, amt);
+                m_blockSize += amt;
+                bytes += amt;
+                size -= amt;
+                if (m_blockSize == sizeof(m_block)) {
+                    this->processBlock();
+                    m_blockSize = 0;
+                }
+            }
+        }
+
+        std::string getHash() {
+            uint64_t bits = m_size * 8;
+            uint8_t padding = 0x80;
+            this->add(&padding, 1);
+            padding = 0;
+            while (m_blockSize != 56) {
+                this->add(&padding, 1);
+            }
+            uint8_t length[8];
+            for (int i = 0; i < 8; i++) {
+                length[i] = static_cast<uint8_t>(bits >> (56 - i * 8));
+            }
+            this->add(length, 8);
+
+            static constexpr char HEX[] = "0123456789abcdef";
+            std::string res;
+            for (auto word : m_state) {
+                for (int shift = 28; shift >= 0; shift -= 4) {
+                    res.push_back(HEX[(word >> shift) & 0xf]);
+                }
+            }
+            return res;
+        }
+    };
+}
+
+std::string calculateGitBlobHash(void const* data, size_t size) {
+    SHA1 sha;
+    auto header = "blob " + std::to_string(size);
+    // the terminating zero is part of the header
+    sha.add(header.c_str(), header.size() + 1);
+    sha.add(data, size);
+    return sha.getHash();
+}
+
+void IncrementalHash::add(void const* data, size_t size) {
+    m_sha.add(data, size);
+    m_size += size;
+}
+
+size_t IncrementalHash::size() const {
+    return m_size;
+}
+
+std::string IncrementalHash::finish() {
+    return m_sha.getHash();
+}
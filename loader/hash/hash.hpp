@@ -2,11 +2,40 @@
 
 #include <string>
 #include <ghc/fs_fwd.hpp>
+#include <Geode/utils/Result.hpp>
+#include "sha3.h"
 
-std::string calculateSHA3_256(ghc::filesystem::path const& path);
+// These are called from worker threads, so read errors are returned instead 
+// of thrown
 
-std::string calculateSHA256(ghc::filesystem::path const& path);
+geode::Result<std::string> calculateSHA3_256(ghc::filesystem::path const& path);
 
-std::string calculateSHA256Text(ghc::filesystem::path const& path);
+geode::Result<std::string> calculateSHA256(ghc::filesystem::path const& path);
 
-std::string calculateHash(ghc::filesystem::path const& path);
+geode::Result<std::string> calculateSHA256Text(ghc::filesystem::path const& path);
+
+geode::Result<std::string> calculateHash(ghc::filesystem::path const& path);
+
+/**
+ * Computes the object ID git gives a blob with the given contents, which is 
+ * what the GitHub API reports as the hash of every file in a repository
+ */
+std::string calculateGitBlobHash(void const* data, size_t size);
+
+/**
+ * Computes the same hash as calculateHash over data fed to it in pieces, so 
+ * downloads can be hashed as they arrive instead of being read back from 
+ * disk afterwards
+ */
+class IncrementalHash {
+    SHA3 m_sha;
+    size_t m_size = 0;
+
+public:
+    void add(void const* data, size_t size);
+    /**
+     * Number of bytes hashed so far
+     */
+    size_t size() const;
+    std::string finish();
+};
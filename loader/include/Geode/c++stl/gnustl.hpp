@@ -2,7 +2,11 @@
 
 #include <algorithm>
 #include <map>
+#include <memory>
 #include <string>
+#include <tuple>
+#include <type_traits>
+#include <utility>
 #include <unordered_map>
 #include <unordered_set>
 #include <set>
@@ -88,61 +92,61 @@ namespace gd {
             return out;
         }
 
-        void insert(_tree_node x, _tree_node p, std::pair<K, V> const& val) {
-            bool insert_left =
-                (x != 0 || p == static_cast<_tree_node>(&m_header) || val.first < p->m_value.first);
-
-            _tree_node z = new _rb_tree_node<std::pair<K, V>>();
-            z->m_value = val;
-
-            _rb_insert_rebalance(insert_left, z, p, m_header);
-            ++m_nodecount;
-        }
-
-        void insert(std::pair<K, V> const& val) {
-            insert_pair(val);
-        }
-
-        void insert_pair(std::pair<K, V> const& val) {
-            _tree_node x = static_cast<_tree_node>(m_header.m_parent);
-            _tree_node y = static_cast<_tree_node>(&m_header);
+        /**
+         * Insert a value with the given key constructed from args, unless the
+         * key is already in the map. Finds the key and the place to insert it
+         * in a single descent down the tree
+         * @returns An iterator to the value with the key, and whether it was
+         * inserted
+         */
+        template <class... Args>
+        std::pair<iterator, bool> try_emplace(K const& key, Args&&... args) {
+            auto header = static_cast<_rb_tree_base*>(&m_header);
+            _rb_tree_base* x = m_header.m_parent;
+            _rb_tree_base* y = header;
             bool comp = true;
-            while (x != 0) {
+            while (x != nullptr) {
                 y = x;
-                comp = val.first < x->m_value.first;
-                x = comp ? static_cast<_tree_node>(x->m_left) : static_cast<_tree_node>(x->m_right);
+                comp = compare(key, static_cast<_tree_node>(x)->m_value.first);
+                x = comp ? x->m_left : x->m_right;
             }
-            auto iter = y;
 
+            // y is where the key would go, so the only node that can have an
+            // equal key is y itself or the one right before it
+            iterator j(y);
             if (comp) {
-                if (iter == static_cast<_tree_node>(m_header.m_left)) {
-                    insert(x, y, val);
-                }
-                else {
-                    iter = static_cast<_tree_node>(_rb_decrement(iter));
+                if (y == m_header.m_left) {
+                    return { this->insert_node(y, true, key, std::forward<Args>(args)...), true };
                 }
+                --j;
             }
-            if (iter->m_value.first < val.first) {
-                insert(x, y, val);
+            if (compare(j->first, key)) {
+                bool insertLeft = y == header || compare(key, static_cast<_tree_node>(y)->m_value.first);
+                return { this->insert_node(y, insertLeft, key, std::forward<Args>(args)...), true };
             }
+            return { j, false };
         }
 
-        map(std::map<K, V> input) {
-            m_header.m_isblack = false;
-            m_header.m_parent = 0;
-            m_header.m_left = &m_header;
-            m_header.m_right = &m_header;
+        void insert(std::pair<K, V> const& val) {
+            this->try_emplace(val.first, val.second);
+        }
+
+        void insert_pair(std::pair<K, V> const& val) {
+            this->try_emplace(val.first, val.second);
+        }
 
-            for (auto i : input) {
-                insert_pair(i);
+        map(std::map<K, V> input) : map() {
+            for (auto& i : input) {
+                this->try_emplace(i.first, i.second);
             }
         }
 
+        // frees the subtree rooted at x without rebalancing
         void erase(_tree_node x) {
             while (x != 0) {
                 erase(static_cast<_tree_node>(x->m_right));
                 auto y = static_cast<_tree_node>(x->m_left);
-                delete y;
+                this->destroy_node(x);
                 x = y;
             }
         }
@@ -181,17 +185,12 @@ namespace gd {
             _tree_node __y = static_cast<_tree_node>(_rb_rebalance_for_erase(
                 __pos.m_node, m_header
             ));
-            delete __y;
+            this->destroy_node(__y);
             --m_nodecount;
         }
 
         V& operator[](K const& __k) {
-            iterator __i = lower_bound(__k);
-            if (__i == end() || compare(__k, (*__i).first)) {
-                insert_pair(std::pair<K, V>(__k, V()));
-                __i = lower_bound(__k);
-            }
-            return (*__i).second;
+            return this->try_emplace(__k).first->second;
         }
 
         iterator begin() noexcept {
@@ -211,7 +210,7 @@ namespace gd {
         }
 
         iterator lower_bound(K const& __x) {
-            _tree_node __j = static_cast<_tree_node>(m_header.m_left);
+            _tree_node __j = static_cast<_tree_node>(m_header.m_parent);
             _tree_node __k = static_cast<_tree_node>(&m_header);
             while (__j != nullptr) {
                 if (!compare(__j->m_value.first, __x)) {
@@ -226,7 +225,7 @@ namespace gd {
         }
 
         iterator upper_bound(K const& __x) {
-            _tree_node __j = static_cast<_tree_node>(m_header.m_left);
+            _tree_node __j = static_cast<_tree_node>(m_header.m_parent);
             _tree_node __k = static_cast<_tree_node>(&m_header);
             while (__j != nullptr) {
                 if (compare(__x, __j->m_value.first)) {
@@ -251,11 +250,44 @@ namespace gd {
 
         map(map const& lol) : map(std::map<K, V>(lol)) {}
 
-        map() : map(std::map<K, V>()) {}
+        map() {
+            m_header.m_isblack = false;
+            m_header.m_parent = 0;
+            m_header.m_left = &m_header;
+            m_header.m_right = &m_header;
+            m_nodecount = 0;
+        }
 
         ~map() {
             erase(static_cast<_tree_node>(m_header.m_parent));
         }
+
+    protected:
+        // nodes go through GD's allocator, since GD may free them itself
+        template <class... Args>
+        iterator insert_node(_rb_tree_base* parent, bool insertLeft, K const& key, Args&&... args) {
+            auto z = gd::allocator<_rb_tree_node<std::pair<K, V>>>().allocate(1);
+            try {
+                new (&z->m_value) std::pair<K, V>(
+                    std::piecewise_construct,
+                    std::forward_as_tuple(key),
+                    std::forward_as_tuple(std::forward<Args>(args)...)
+                );
+            }
+            catch (...) {
+                gd::allocator<_rb_tree_node<std::pair<K, V>>>().deallocate(z, 1);
+                throw;
+            }
+            _rb_insert_rebalance(insertLeft, z, parent, m_header);
+            ++m_nodecount;
+            return iterator(z);
+        }
+
+        void destroy_node(_tree_node x) {
+            x->m_value.~pair();
+            gd::allocator<_rb_tree_node<std::pair<K, V>>>().deallocate(x, 1);
+        }
+
     };
 
     // template <class Type>
@@ -291,27 +323,11 @@ namespace gd {
         }
 
         vector(std::vector<T> const& input) : vector() {
-            if (input.size()) {
-                auto capacity = nextCapacity(input.size());
-                m_start = this->allocator().allocate(capacity);
-                m_finish = m_start + input.size();
-                m_reserveEnd = m_start + capacity;
-
-                std::uninitialized_default_construct(m_start, m_finish);
-                std::copy(input.begin(), input.end(), m_start);
-            }
+            this->assign(input.begin(), input.end(), input.size());
         }
 
         vector(gd::vector<T> const& input) : vector() {
-            if (input.size()) {
-                auto capacity = nextCapacity(input.size());
-                m_start = this->allocator().allocate(capacity);
-                m_finish = m_start + input.size();
-                m_reserveEnd = m_start + capacity;
-
-                std::uninitialized_default_construct(m_start, m_finish);
-                std::copy(input.begin(), input.end(), m_start);
-            }
+            this->assign(input.begin(), input.end(), input.size());
         }
 
         vector(gd::vector<T>&& input) : vector() {
@@ -325,102 +341,141 @@ namespace gd {
         }
 
         vector& operator=(gd::vector<T> const& input) {
-            this->clear();
-
-            if (input.size()) {
-                auto capacity = nextCapacity(input.size());
-                m_start = this->allocator().allocate(capacity);
-                m_finish = m_start + input.size();
-                m_reserveEnd = m_start + capacity;
-
-                std::uninitialized_default_construct(m_start, m_finish);
-                std::copy(input.begin(), input.end(), m_start);
+            if (this != &input) {
+                this->clear();
+                this->assign(input.begin(), input.end(), input.size());
             }
-
             return *this;
         }
 
         vector& operator=(gd::vector<T>&& input) {
-            m_start = input.m_start;
-            m_finish = input.m_finish;
-            m_reserveEnd = input.m_reserveEnd;
+            if (this != &input) {
+                this->clear();
 
-            input.m_start = nullptr;
-            input.m_finish = nullptr;
-            input.m_reserveEnd = nullptr;
+                m_start = input.m_start;
+                m_finish = input.m_finish;
+                m_reserveEnd = input.m_reserveEnd;
 
+                input.m_start = nullptr;
+                input.m_finish = nullptr;
+                input.m_reserveEnd = nullptr;
+            }
             return *this;
         }
 
+        /**
+         * Make sure the vector can hold at least capacity elements without
+         * reallocating
+         */
+        void reserve(size_t capacity) {
+            if (capacity > this->capacity()) {
+                this->reallocate(capacity);
+            }
+        }
+
         void grow() {
             if (m_finish == m_reserveEnd) {
-                auto newSize = this->capacity() * 2;
-                auto newStart = this->allocator().allocate(newSize);
-                auto newFinish = newStart + this->size();
-
-                std::uninitialized_default_construct(newStart, newFinish);
-                std::copy(m_start, m_finish, newStart);
-
-                std::destroy(m_start, m_finish);
-                this->allocator().deallocate(m_start, this->capacity());
-
-                m_start = newStart;
-                m_finish = newFinish;
-                m_reserveEnd = newStart + newSize;
+                this->reallocate(this->grownCapacity(this->size() + 1));
             }
         }
 
-        void shrink() {
-            if (m_finish < m_reserveEnd / 2 && this->capacity() > 16) {
-                auto newSize = this->capacity() / 2;
-                auto newStart = this->allocator().allocate(newSize);
-                auto newFinish = newStart + this->size();
-
-                std::uninitialized_default_construct(newStart, newFinish);
-                std::copy(m_start, m_finish, newStart);
-
-                std::destroy(m_start, m_finish);
-                this->allocator().deallocate(m_start, this->capacity());
+        template <class... Args>
+        T& emplace_back(Args&&... args) {
+            if (m_finish != m_reserveEnd) {
+                new (m_finish) T(std::forward<Args>(args)...);
+                return *m_finish++;
+            }
 
-                m_start = newStart;
-                m_finish = newFinish;
-                m_reserveEnd = newStart + newSize;
+            // construct the new element before moving the old ones over, as
+            // args may refer to an element of this vector
+            auto size = this->size();
+            auto capacity = this->grownCapacity(size + 1);
+            auto newStart = this->allocator().allocate(capacity);
+            try {
+                new (newStart + size) T(std::forward<Args>(args)...);
+            }
+            catch (...) {
+                this->allocator().deallocate(newStart, capacity);
+                throw;
+            }
+            try {
+                this->relocate(newStart, capacity);
             }
+            catch (...) {
+                newStart[size].~T();
+                this->allocator().deallocate(newStart, capacity);
+                throw;
+            }
+            return *m_finish++;
         }
 
         void push_back(T const& input) {
-            this->grow();
-
-            new (m_finish) T(input);
-            ++m_finish;
+            this->emplace_back(input);
         }
 
         void push_back(T&& input) {
-            this->grow();
-
-            new (m_finish) T(std::move(input));
-            ++m_finish;
+            this->emplace_back(std::move(input));
+        }
+
+        /**
+         * Insert a value before pos
+         * @returns A pointer to the inserted value
+         */
+        T* insert(T const* pos, T value) {
+            auto index = pos - m_start;
+            this->emplace_back(std::move(value));
+            std::rotate(m_start + index, m_finish - 1, m_finish);
+            return m_start + index;
+        }
+
+        /**
+         * Insert the elements of [first, last) before pos. Like std::vector,
+         * the range may not point into this vector
+         * @returns A pointer to the first inserted value
+         */
+        template <class It>
+            requires (!std::is_integral_v<It>)
+        T* insert(T const* pos, It first, It last) {
+            auto index = pos - m_start;
+            auto oldSize = this->size();
+            if constexpr (std::is_base_of_v<
+                std::forward_iterator_tag, typename std::iterator_traits<It>::iterator_category
+            >) {
+                auto count = static_cast<size_t>(std::distance(first, last));
+                if (oldSize + count > this->capacity()) {
+                    this->reallocate(this->grownCapacity(oldSize + count));
+                }
+            }
+            for (; first != last; ++first) {
+                this->emplace_back(*first);
+            }
+            std::rotate(m_start + index, m_start + oldSize, m_finish);
+            return m_start + index;
         }
 
         void pop_back() {
+            // capacity is kept, just like std::vector, so pushing again
+            // doesn't reallocate
             if (m_finish != m_start) {
                 --m_finish;
                 m_finish->~T();
             }
+        }
 
-            this->shrink();
+        /**
+         * Release unused capacity
+         */
+        void shrink() {
+            if (m_finish == m_start) {
+                this->clear();
+            }
+            else if (m_finish != m_reserveEnd) {
+                this->reallocate(this->size());
+            }
         }
 
         vector(std::initializer_list<T> const& input) : vector() {
-            if (input.size()) {
-                auto capacity = nextCapacity(input.size());
-                m_start = this->allocator().allocate(capacity);
-                m_finish = m_start + input.size();
-                m_reserveEnd = m_start + capacity;
-
-                std::uninitialized_default_construct(m_start, m_finish);
-                std::copy(input.begin(), input.end(), m_start);
-            }
+            this->assign(input.begin(), input.end(), input.size());
         }
 
         void clear() {
@@ -461,6 +516,10 @@ namespace gd {
             return *m_start;
         }
 
+        T& back() {
+            return *(m_finish - 1);
+        }
+
         T* begin() {
             return m_start;
         }
@@ -478,12 +537,7 @@ namespace gd {
         }
 
         ~vector() {
-            if (m_start) {
-                for (auto& x : *this) {
-                    x.~T();
-                }
-                delete m_start;
-            }
+            this->clear();
         }
 
         size_t size() const {
@@ -494,10 +548,67 @@ namespace gd {
             return m_reserveEnd - m_start;
         }
 
+        bool empty() const {
+            return m_finish == m_start;
+        }
+
     protected:
         T* m_start;
         T* m_finish;
         T* m_reserveEnd;
+
+        size_t grownCapacity(size_t size) {
+            return std::max(this->nextCapacity(size), this->capacity() * 2);
+        }
+
+        // copy a range into this empty vector
+        template <class It>
+        void assign(It first, It last, size_t size) {
+            if (size) {
+                auto capacity = this->nextCapacity(size);
+                m_start = this->allocator().allocate(capacity);
+                m_reserveEnd = m_start + capacity;
+                try {
+                    m_finish = std::uninitialized_copy(first, last, m_start);
+                }
+                catch (...) {
+                    this->allocator().deallocate(m_start, capacity);
+                    m_start = m_finish = m_reserveEnd = nullptr;
+                    throw;
+                }
+            }
+        }
+
+        // move the elements into a new buffer, which may already have
+        // elements constructed past them. if copying an element throws, the
+        // vector is left untouched and the caller still owns the new buffer
+        void relocate(T* newStart, size_t capacity) {
+            auto size = this->size();
+            if constexpr (std::is_nothrow_move_constructible_v<T> || !std::is_copy_constructible_v<T>) {
+                std::uninitialized_move(m_start, m_finish, newStart);
+            }
+            else {
+                std::uninitialized_copy(m_start, m_finish, newStart);
+            }
+            if (m_start) {
+                std::destroy(m_start, m_finish);
+                this->allocator().deallocate(m_start, this->capacity());
+            }
+            m_start = newStart;
+            m_finish = newStart + size;
+            m_reserveEnd = newStart + capacity;
+        }
+
+        void reallocate(size_t capacity) {
+            auto newStart = this->allocator().allocate(capacity);
+            try {
+                this->relocate(newStart, capacity);
+            }
+            catch (...) {
+                this->allocator().deallocate(newStart, capacity);
+                throw;
+            }
+        }
     };
 
     struct _bit_reference {
@@ -64,18 +64,40 @@ namespace gd {
 	public:
 		string();
 		string(string const&);
-		// string(string&&);
+		string(string&&) noexcept;
 		string(char const*);
 		string(std::string const&);
-		// tried to add a string_view ctor, but got overload errors :(
+		// implicit string_view ctor causes overload errors :(
+		explicit string(std::string_view);
 		~string();
 
 		string& operator=(string const&);
-		string& operator=(string&&);
+		string& operator=(string&&) noexcept;
 		string& operator=(char const*);
 		string& operator=(std::string const&);
+		string& operator=(std::string_view);
 
 		void clear();
+
+		/**
+		 * Make sure the string can hold at least cap characters without
+		 * reallocating
+		 */
+		void reserve(size_t cap);
+		/**
+		 * Resize the string, filling any new characters with ch
+		 */
+		void resize(size_t size, char ch = '\0');
+		string& append(std::string_view str);
+		void push_back(char ch);
+
+		string& operator+=(std::string_view str) {
+			return this->append(str);
+		}
+		string& operator+=(char ch) {
+			this->push_back(ch);
+			return *this;
+		}
 		
 		char& at(size_t pos);
 		char const& at(size_t pos) const;
@@ -26,6 +26,7 @@ THE SOFTWARE.
 #define __SUPPORT_ZIPUTILS_H__
 
 #include <string>
+#include <string_view>
 #include <ghc/fs_fwd.hpp>
 #include "../../platform/CCPlatformDefine.h"
 #include "../../platform/CCPlatformConfig.h"
@@ -165,6 +166,53 @@ namespace cocos2d
         static unsigned char hexToChar(const gd::string&);
         static gd::string urlDecode(const gd::string&);
 
+        /**
+         * Decode a base64 string. Both the standard (+/) and the URL-safe 
+         * (-_) alphabets are accepted, and padding is optional. Decoding is 
+         * vectorized where the target supports it
+         * @param data The base64 string
+         * @param out Where to write the decoded bytes
+         * @returns True if the string was valid base64, false otherwise
+         * @note Geode addition
+         */
+        static GEODE_DLL bool base64Decode(std::string_view data, std::string& out);
+        /**
+         * Encode bytes as padded base64
+         * @param data The bytes to encode
+         * @param urlSafe Whether to use the URL-safe alphabet (-_) like GD 
+         * does for level strings and saves
+         * @note Geode addition
+         */
+        static GEODE_DLL std::string base64Encode(std::string_view data, bool urlSafe = true);
+        /**
+         * Faster equivalent of decompressString. The string is XOR-decrypted, 
+         * base64-decoded and inflated in one streaming pass without any 
+         * intermediate copies, and gzip data is inflated straight into a 
+         * buffer of the size recorded in its trailer
+         * @param data The compressed string, such as a level string or the 
+         * contents of CCLocalLevels.dat
+         * @param isEncrypted Whether the string is XOR-obfuscated
+         * @param key The XOR key, if isEncrypted is true
+         * @returns The decompressed data, or an empty string on failure
+         * @note Geode addition
+         */
+        static GEODE_DLL std::string decompressStringFast(
+            std::string_view data, bool isEncrypted = false, int key = 11
+        );
+        /**
+         * Faster equivalent of compressString. The data is gzip-deflated into 
+         * an exactly sized buffer and then base64-encoded and optionally 
+         * XOR-obfuscated in the same pass
+         * @param data The data to compress
+         * @param isEncrypted Whether to XOR-obfuscate the result
+         * @param key The XOR key, if isEncrypted is true
+         * @returns The compressed string, or an empty string on failure
+         * @note Geode addition
+         */
+        static GEODE_DLL std::string compressStringFast(
+            std::string_view data, bool isEncrypted = false, int key = 11
+        );
+
     private:
         static int ccInflateMemoryWithHint(unsigned char *in, unsigned int inLength, unsigned char **out, unsigned int *outLength, 
                                            unsigned int outLenghtHint);
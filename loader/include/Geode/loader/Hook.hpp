@@ -4,14 +4,71 @@
 #include "../utils/general.hpp"
 #include <matjson.hpp>
 #include "Tulip.hpp"
+#include <atomic>
+#include <chrono>
 #include <cinttypes>
+#include <optional>
 #include <string_view>
+#include <vector>
 #include <tulip/TulipHook.hpp>
 
 namespace geode {
     class Mod;
     class Loader;
 
+    /**
+     * Raw counters for a single hook, filled in while hook profiling is
+     * enabled. Use Hook::getProfileInfo to read them
+     */
+    struct HookProfile final {
+        std::atomic<uint64_t> calls = 0;
+        std::atomic<uint64_t> inclusiveNs = 0;
+        std::atomic<uint64_t> exclusiveNs = 0;
+        /// The mod that owns the hook, for frame time attribution
+        Mod* owner = nullptr;
+    };
+
+    /**
+     * A snapshot of a hook's profiling counters
+     */
+    struct HookProfileInfo final {
+        uint64_t calls = 0;
+        /// Total time spent in the detour, including everything it called
+        std::chrono::nanoseconds inclusiveTime{};
+        /// Total time spent in the detour itself, excluding time spent in
+        /// other profiled hooks it called (including the rest of its own
+        /// detour chain through the original)
+        std::chrono::nanoseconds exclusiveTime{};
+    };
+
+    /**
+     * Times a single call of a profiled detour. Only used by the profiled
+     * detours generated by $modify
+     */
+    class GEODE_DLL HookProfileScope final {
+    private:
+        HookProfile* m_profile;
+        HookProfileScope* m_parent;
+        int64_t m_start;
+        int64_t m_childNs = 0;
+
+    public:
+        explicit HookProfileScope(HookProfile* profile);
+        ~HookProfileScope();
+
+        /**
+         * Get the owner of the innermost profiled call running on this 
+         * thread, which is the mod whose code is running if it's called 
+         * from a hook. Calls owned by Geode itself are skipped
+         * @returns The owner, or nullptr if no profiled call owned by a mod 
+         * is running
+         */
+        static Mod* currentOwner();
+
+        HookProfileScope(HookProfileScope const&) = delete;
+        HookProfileScope& operator=(HookProfileScope const&) = delete;
+    };
+
     class GEODE_DLL Hook final {
     private:
         class Impl;
@@ -84,10 +141,33 @@ namespace geode {
          */
         [[nodiscard]] bool isEnabled() const;
 
+        /**
+         * Enable the hook. This also works on hooks that are waiting for 
+         * their mod's binary to finish loading, which are then enabled 
+         * right away instead of with the rest
+         */
         Result<> enable();
 
         Result<> disable();
 
+        /**
+         * Enable many hooks at once. This is faster than enabling them one
+         * by one, as hooks on the same function share a single handler
+         * lookup, and only one summary line is logged for the whole batch
+         * @param hooks The hooks to enable. Hooks that are already enabled
+         * are skipped
+         * @returns An error if any of the hooks failed to enable; the
+         * individual errors are logged under each hook's owner
+         */
+        static Result<> enableBatch(std::vector<Hook*> const& hooks);
+
+        /**
+         * Disable many hooks at once, see enableBatch
+         * @param hooks The hooks to disable. Hooks that are already
+         * disabled are skipped
+         */
+        static Result<> disableBatch(std::vector<Hook*> const& hooks);
+
         /**
         * Get whether the hook should be auto enabled or not.
         * @returns Auto enable
@@ -141,6 +221,55 @@ namespace geode {
          * @param priority Priority
          */
         void setPriority(int32_t priority);
+
+        /**
+         * Provide an instrumented version of this hook's detour that is
+         * swapped in while hook profiling is enabled. Hooks created through
+         * $modify do this automatically
+         * @param detour The instrumented detour. It should time itself with
+         * a HookProfileScope on the profile stored in profileSlot
+         * @param profileSlot Where the hook should store the address of its
+         * profile before the instrumented detour is first enabled
+         */
+        void setProfiledDetour(void* detour, HookProfile** profileSlot);
+
+        /**
+         * Get this hook's profiling counters
+         * @returns The counters, or std::nullopt if this hook has no
+         * instrumented detour and can't be profiled
+         */
+        [[nodiscard]] std::optional<HookProfileInfo> getProfileInfo() const;
+
+        /**
+         * Enable or disable hook profiling. While enabled, every hook that
+         * can be profiled runs through its instrumented detour, which
+         * records call counts and inclusive / exclusive time, and a summary
+         * of the most expensive hooks is logged periodically. While
+         * disabled the original detours are used, so there is no overhead.
+         * Profiling can also be enabled at startup with the
+         * `--geode:enable-hook-profiler` launch argument. It can't be 
+         * disabled while frame time attribution is enabled, as that relies 
+         * on it
+         * @note Must be called on the main thread
+         */
+        static void setProfilingEnabled(bool enabled);
+
+        /**
+         * Get whether hook profiling is enabled
+         */
+        [[nodiscard]] static bool isProfilingEnabled();
+
+        /**
+         * Get the measured cost of instrumenting a single hook call, which
+         * is included in every profiled call's inclusive time. This is
+         * measured each time profiling is enabled
+         */
+        [[nodiscard]] static std::chrono::nanoseconds getProfilingOverhead();
+
+        /**
+         * Reset the profiling counters of every hook
+         */
+        static void resetProfiles();
     };
 
     class GEODE_DLL Patch final {
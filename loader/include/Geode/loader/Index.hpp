@@ -116,6 +116,11 @@ namespace geode {
          */
         ghc::filesystem::path getPath() const;
         ModMetadata getMetadata() const;
+        /**
+         * Same as getMetadata, but without copying. Valid for as long as the 
+         * item is alive
+         */
+        ModMetadata const& getMetadataRef() const;
         std::string getDownloadURL() const;
         std::string getPackageHash() const;
         std::unordered_set<PlatformID> getAvailablePlatforms() const;
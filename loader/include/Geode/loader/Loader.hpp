@@ -77,6 +77,10 @@ namespace geode {
 
         bool isForwardCompatMode();
 
+        /**
+         * Save the data of every loaded mod. The files are written on a 
+         * background thread and are only waited on when the game exits
+         */
         void saveData();
         void loadData();
 
@@ -140,6 +144,21 @@ namespace geode {
 
         void queueInMainThread(ScheduledFunction func);
 
+        /**
+         * Enable or disable frame time attribution. While enabled, the main
+         * thread time spent in each mod's hooks, in the functions it queued 
+         * with queueInMainThread, and in the selectors it scheduled and 
+         * actions it ran is added up every frame; see 
+         * Mod::getRecentFrameTimes. Selectors and actions are only counted if 
+         * they were scheduled or run while attribution was enabled. This 
+         * turns on hook profiling too, as hook time is measured through it, 
+         * and hook profiling can't be turned off until attribution is. While 
+         * disabled, nothing is measured
+         * @note Must be called on the main thread
+         */
+        void setFrameTimeAttributionEnabled(bool enabled);
+        bool isFrameTimeAttributionEnabled() const;
+
         friend class LoaderImpl;
 
         friend Mod* takeNextLoaderMod();
@@ -11,12 +11,14 @@
 #include "Types.hpp"
 #include "Loader.hpp"
 
+#include <chrono>
 #include <matjson.hpp>
 #include <optional>
 #include <string_view>
 #include <tulip/TulipHook.hpp>
 #include <type_traits>
 #include <unordered_map>
+#include <utility>
 #include <vector>
 
 namespace geode {
@@ -84,12 +86,32 @@ namespace geode {
         std::vector<std::string> getDevelopers() const;
         std::optional<std::string> getDescription() const;
         std::optional<std::string> getDetails() const;
+        /**
+         * Same as getID, but without copying. See ModMetadata::getIDRef; the 
+         * returned ID is interned, so it can be compared by address and 
+         * stays valid for the rest of the game's lifetime
+         */
+        std::string const& getIDRef() const;
+        /**
+         * Non-copying versions of the getters above. The references are 
+         * valid until the mod's metadata is replaced, which only happens 
+         * when the mod is reloaded
+         */
+        std::string const& getNameRef() const;
+        std::vector<std::string> const& getDevelopersRef() const;
+        std::optional<std::string> const& getDescriptionRef() const;
+        std::optional<std::string> const& getDetailsRef() const;
         ghc::filesystem::path getPackagePath() const;
         VersionInfo getVersion() const;
         bool isEnabled() const;
         bool isInternal() const;
         bool needsEarlyLoad() const;
         ModMetadata getMetadata() const;
+        /**
+         * Same as getMetadata, but without copying. Valid until the mod's 
+         * metadata is replaced
+         */
+        ModMetadata const& getMetadataRef() const;
         ghc::filesystem::path getTempDir() const;
         /**
          * Get the path to the mod's platform binary (.dll on Windows, .dylib
@@ -117,6 +139,12 @@ namespace geode {
          */
         std::optional<VersionInfo> hasAvailableUpdate() const;
 
+        /**
+         * Save the mod's settings and saved values. The values are 
+         * serialized right away, but the files are written on a background 
+         * thread, so they may not be on disk yet when this returns; files 
+         * whose contents haven't changed aren't rewritten
+         */
         Result<> saveData();
         Result<> loadData();
 
@@ -202,7 +230,13 @@ namespace geode {
             return Loader::get()->parseLaunchArgument<T>(this->getLaunchArgumentName(name));
         }
 
+        /**
+         * Get the container of the mod's saved values. Changes made through 
+         * the reference, even long after getting it, are written on the 
+         * next save
+         */
         matjson::Value& getSaveContainer();
+        matjson::Value const& getSaveContainer() const;
 
         template <class T>
         T getSettingValue(std::string_view const key) const {
@@ -226,7 +260,7 @@ namespace geode {
 
         template <class T>
         T getSavedValue(std::string_view const key) {
-            auto& saved = this->getSaveContainer();
+            auto& saved = std::as_const(*this).getSaveContainer();
             if (saved.contains(key)) {
                 if (auto value = saved.try_get<T>(key)) {
                     return *value;
@@ -288,6 +322,10 @@ namespace geode {
          * @returns Successful result containing the
          * Hook pointer, errorful result with info on
          * error
+         * @note Hooks claimed while the mod's binary is loading, which 
+         * includes $execute blocks, aren't enabled until it has finished 
+         * loading, so they're all enabled together. Call Hook::enable on the 
+         * result if the hook has to be active straight away
          */
         template<class DetourType>
         Result<Hook*> hook(
@@ -315,6 +353,10 @@ namespace geode {
          * If the hook has "auto enable" set, this will enable the hook.
          * @returns Returns a pointer to the hook, or an error if the
          * hook already has an owner, or was unable to enable the hook.
+         * @note Hooks claimed while the mod's binary is loading, which 
+         * includes $execute blocks, aren't enabled until it has finished 
+         * loading, so they're all enabled together. Call Hook::enable on the 
+         * result if the hook has to be active straight away
          */
         Result<Hook*> claimHook(std::shared_ptr<Hook> hook);
 
@@ -422,6 +464,14 @@ namespace geode {
          */
         ModJson getRuntimeInfo() const;
 
+        /**
+         * Get how much main thread time was spent in this mod's code in
+         * each of the most recent frames, oldest first. Only recorded while
+         * frame time attribution is enabled
+         * @see Loader::setFrameTimeAttributionEnabled
+         */
+        std::vector<std::chrono::nanoseconds> getRecentFrameTimes() const;
+
         bool isLoggingEnabled() const;
         void setLoggingEnabled(bool enabled);
 
@@ -7,6 +7,7 @@
 
 #include <matjson.hpp>
 #include <memory>
+#include <string_view>
 
 namespace geode {
     namespace utils::file {
@@ -78,6 +79,19 @@ namespace geode {
          * numbers, dashes, underscores, and a single separating dot
          */
         [[nodiscard]] std::string getID() const;
+        /**
+         * Same as getID, but without copying. The returned string is 
+         * interned: every ModMetadata with the same ID returns a reference 
+         * to the same string, so IDs can be compared by address. The 
+         * reference stays valid for the rest of the game's lifetime
+         */
+        [[nodiscard]] std::string const& getIDRef() const;
+        /**
+         * Get the interned copy of a mod ID. Comparing the address of the 
+         * result with ModMetadata::getIDRef or Mod::getIDRef tells whether 
+         * the IDs are equal in constant time
+         */
+        [[nodiscard]] static std::string const& internID(std::string_view id);
         /**
          * True if the mod has a mod ID that will be rejected in the future, 
          * such as using uppercase letters or having multiple dots. Mods like 
@@ -91,6 +105,12 @@ namespace geode {
          * character set.
          */
         [[nodiscard]] std::string getName() const;
+        /**
+         * Same as getName, but without copying. The name is interned, so 
+         * the reference stays valid for the rest of the game's 
+         * lifetime, but won't reflect later changes to the name
+         */
+        [[nodiscard]] std::string const& getNameRef() const;
         /**
          * The name of the head developer.
          * If the mod has multiple * developers, this will return the first 
@@ -102,31 +122,37 @@ namespace geode {
          * The developers of this mod
          */
         [[nodiscard]] std::vector<std::string> getDevelopers() const;
+        [[nodiscard]] std::vector<std::string> const& getDevelopersRef() const;
         /**
          * Short & concise description of the
          * mod.
          */
         [[nodiscard]] std::optional<std::string> getDescription() const;
+        [[nodiscard]] std::optional<std::string> const& getDescriptionRef() const;
         /**
          * Detailed description of the mod, written in Markdown (see
          * <Geode/ui/MDTextArea.hpp>) for more info
          */
         [[nodiscard]] std::optional<std::string> getDetails() const;
+        [[nodiscard]] std::optional<std::string> const& getDetailsRef() const;
         /**
          * Changelog for the mod, written in Markdown (see
          * <Geode/ui/MDTextArea.hpp>) for more info
          */
         [[nodiscard]] std::optional<std::string> getChangelog() const;
+        [[nodiscard]] std::optional<std::string> const& getChangelogRef() const;
         /**
          * Support info for the mod; this means anything to show ways to
          * support the mod's development, like donations. Written in Markdown
          * (see MDTextArea for more info)
          */
         [[nodiscard]] std::optional<std::string> getSupportInfo() const;
+        [[nodiscard]] std::optional<std::string> const& getSupportInfoRef() const;
         /**
          * Git Repository of the mod
          */
         [[nodiscard]] std::optional<std::string> getRepository() const;
+        [[nodiscard]] std::optional<std::string> const& getRepositoryRef() const;
         /**
          * Info about where users should report issues and request help
          */
@@ -135,19 +161,23 @@ namespace geode {
          * Dependencies
          */
         [[nodiscard]] std::vector<Dependency> getDependencies() const;
+        [[nodiscard]] std::vector<Dependency> const& getDependenciesRef() const;
         /**
          * Incompatibilities
          */
         [[nodiscard]] std::vector<Incompatibility> getIncompatibilities() const;
+        [[nodiscard]] std::vector<Incompatibility> const& getIncompatibilitiesRef() const;
         /**
          * Mod spritesheet names
          */
         [[nodiscard]] std::vector<std::string> getSpritesheets() const;
+        [[nodiscard]] std::vector<std::string> const& getSpritesheetsRef() const;
         /**
          * Mod settings
          * @note Not a map because insertion order must be preserved
          */
         [[nodiscard]] std::vector<std::pair<std::string, Setting>> getSettings() const;
+        [[nodiscard]] std::vector<std::pair<std::string, Setting>> const& getSettingsRef() const;
         /**
          * Whether this mod has to be loaded before the loading screen or not
          */
@@ -5,6 +5,7 @@
 #include "../utils/Result.hpp"
 #include "../utils/file.hpp"
 #include <matjson.hpp>
+#include <memory>
 #include <optional>
 #include <unordered_set>
 #include <cocos2d.h>
@@ -12,6 +13,10 @@
 #pragma warning(push)
 #pragma warning(disable : 4275)
 
+namespace re2 {
+    class RE2;
+}
+
 namespace geode {
     class SettingNode;
     class SettingValue;
@@ -95,6 +100,12 @@ namespace geode {
          * A regex the string must successfully match against
          */
         std::optional<std::string> match;
+        /**
+         * The compiled form of match, built when the setting is parsed.
+         * Compiled patterns are shared between all settings with the same
+         * pattern
+         */
+        std::shared_ptr<re2::RE2 const> compiledMatch;
 
         /**
          * The CCTextInputNode's allowed character filter
@@ -18,6 +18,8 @@ namespace geode {
     protected:
         std::string m_modID;
         std::optional<std::string> m_targetKey;
+        // interned m_modID, so events can be matched by comparing addresses
+        std::string const* m_internedModID;
 
     public:
         using Callback = void(SettingValue*);
@@ -45,7 +47,7 @@ namespace geode {
 
         ListenerResult handle(utils::MiniFunction<Callback> fn, SettingChangedEvent* event) {
             if (
-                m_modID == event->mod->getID() &&
+                m_internedModID == &event->mod->getIDRef() &&
                 (!m_targetKey || m_targetKey.value() == event->value->getKey())
             ) {
                 fn(SettingValueSetter<T>::get(event->value));
@@ -0,0 +1,124 @@
+#pragma once
+
+#include "Mod.hpp"
+#include "SettingEvent.hpp"
+
+#include <atomic>
+#include <memory>
+#include <string_view>
+#include <type_traits>
+#include <vector>
+
+namespace geode {
+    namespace detail {
+        template <class T>
+        struct IsAlwaysLockFree : std::bool_constant<std::atomic<T>::is_always_lock_free> {};
+    }
+
+    /**
+     * A typed handle to one of a mod's settings that caches its current
+     * value. Unlike Mod::getSettingValue, reading through a handle doesn't
+     * look the setting up by key or allocate; it's a single atomic load, so
+     * handles are meant for hot paths like per-frame hooks. Reads are also
+     * safe from any thread. The cached value is updated whenever the setting
+     * posts a SettingChangedEvent, which the built-in settings do every time
+     * their value changes
+     * @note Handles should be created on the main thread, after the mod's
+     * settings have been loaded (for example in $execute or $on_mod(Loaded))
+     * @example
+     * static SettingHandle<bool> s_enabled;
+     * $execute {
+     *     s_enabled = SettingHandle<bool>("enabled");
+     * }
+     * // in some hook
+     * if (s_enabled.get()) { ... }
+     */
+    template <class T>
+    class SettingHandle final {
+    public:
+        // small trivial values are stored directly in an atomic, anything
+        // else is published as an immutable snapshot through an atomic pointer
+        static constexpr bool IS_INLINE = std::conjunction_v<
+            std::is_trivially_copyable<T>, detail::IsAlwaysLockFree<T>
+        >;
+        using ReadType = std::conditional_t<IS_INLINE, T, T const&>;
+
+    protected:
+        struct InlineStorage {
+            std::atomic<T> value;
+
+            void publish(T const& newValue) {
+                value.store(newValue, std::memory_order_release);
+            }
+            T read() const {
+                return value.load(std::memory_order_acquire);
+            }
+        };
+        struct SnapshotStorage {
+            std::atomic<T const*> current = nullptr;
+            // a reader on another thread may still be holding a reference to
+            // an older snapshot, so they're only freed with the handle. This
+            // is fine since settings only change through the settings UI or
+            // setSettingValue, both of which are rare
+            std::vector<std::unique_ptr<T const>> snapshots;
+
+            void publish(T const& newValue) {
+                snapshots.push_back(std::make_unique<T const>(newValue));
+                current.store(snapshots.back().get(), std::memory_order_release);
+            }
+            T const& read() const {
+                return *current.load(std::memory_order_acquire);
+            }
+        };
+        struct State {
+            std::conditional_t<IS_INLINE, InlineStorage, SnapshotStorage> storage;
+            // declared last so it's destroyed before the storage it writes to
+            std::unique_ptr<EventListener<GeodeSettingChangedFilter<T>>> listener;
+        };
+        std::shared_ptr<State> m_state;
+
+    public:
+        /**
+         * Create an empty handle. Calling get on an empty handle is UB
+         */
+        SettingHandle() = default;
+        /**
+         * Create a handle to a setting
+         * @param mod The mod whose setting this is
+         * @param key The setting's key
+         */
+        SettingHandle(Mod* mod, std::string_view const key) : m_state(std::make_shared<State>()) {
+            m_state->storage.publish(mod->template getSettingValue<T>(key));
+            m_state->listener = std::make_unique<EventListener<GeodeSettingChangedFilter<T>>>(
+                [state = m_state.get()](T value) {
+                    state->storage.publish(value);
+                },
+                GeodeSettingChangedFilter<T>(mod->getID(), std::string(key))
+            );
+        }
+        /**
+         * Create a handle to one of the current mod's settings
+         * @param key The setting's key
+         */
+        SettingHandle(std::string_view const key) : SettingHandle(getMod(), key) {}
+
+        /**
+         * Get the setting's current value
+         * @note For types that aren't stored inline, the returned reference
+         * stays valid for as long as this handle (or a copy of it) is alive,
+         * but won't reflect later changes
+         */
+        ReadType get() const {
+            return m_state->storage.read();
+        }
+        ReadType operator*() const {
+            return this->get();
+        }
+        bool isValid() const {
+            return m_state != nullptr;
+        }
+        explicit operator bool() const {
+            return this->isValid();
+        }
+    };
+}
@@ -1,15 +1,19 @@
 #pragma once
 #include "../utils/addresser.hpp"
 #include "Traits.hpp"
+#include "../loader/Hook.hpp"
 #include "../loader/Log.hpp"
 
 namespace geode::modifier {
 /**
- * A helper struct that generates a static function that calls the given function.
+ * A helper struct that generates a static function that calls the given function,
+ * along with an instrumented copy of it that is swapped in while hook profiling
+ * is enabled.
  */
 #define GEODE_AS_STATIC_FUNCTION(FunctionName_)                                                   \
     template <class Class2, class FunctionType>                                                   \
     struct AsStaticFunction_##FunctionName_ {                                                     \
+        static inline HookProfile* profile = nullptr;                                             \
         template <class FunctionType2>                                                            \
         struct Impl {};                                                                           \
         template <class Return, class... Params>                                                  \
@@ -17,6 +21,10 @@ namespace geode::modifier {
             static Return GEODE_CDECL_CALL function(Params... params) {                           \
                 return Class2::FunctionName_(params...);                                          \
             }                                                                                     \
+            static Return GEODE_CDECL_CALL profiledFunction(Params... params) {                   \
+                HookProfileScope scope(profile);                                                  \
+                return function(params...);                                                       \
+            }                                                                                     \
         };                                                                                        \
         template <class Return, class Class, class... Params>                                     \
         struct Impl<Return (Class::*)(Params...)> {                                               \
@@ -26,6 +34,10 @@ namespace geode::modifier {
                 );                                                                                \
                 return self2->Class2::FunctionName_(params...);                                   \
             }                                                                                     \
+            static Return GEODE_CDECL_CALL profiledFunction(Class* self, Params... params) {      \
+                HookProfileScope scope(profile);                                                  \
+                return function(self, params...);                                                 \
+            }                                                                                     \
         };                                                                                        \
         template <class Return, class Class, class... Params>                                     \
         struct Impl<Return (Class::*)(Params...) const> {                                         \
@@ -35,8 +47,13 @@ namespace geode::modifier {
                 );                                                                                \
                 return self2->Class2::FunctionName_(params...);                                   \
             }                                                                                     \
+            static Return GEODE_CDECL_CALL profiledFunction(Class const* self, Params... params) { \
+                HookProfileScope scope(profile);                                                  \
+                return function(self, params...);                                                 \
+            }                                                                                     \
         };                                                                                        \
         static constexpr auto value = &Impl<FunctionType>::function;                              \
+        static constexpr auto profiledValue = &Impl<FunctionType>::profiledFunction;              \
     };
 
     GEODE_AS_STATIC_FUNCTION(constructor)
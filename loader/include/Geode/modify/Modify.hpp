@@ -20,14 +20,17 @@
                 );                                                                                   \
                 break;                                                                               \
             }                                                                                        \
+            using StaticFunction = AsStaticFunction_##FunctionName_<                                 \
+                Derived, decltype(Resolve<__VA_ARGS__>::func(&Derived::FunctionName_))>;             \
             auto hook = Hook::create(                                                                \
                 reinterpret_cast<void*>(address),                                                    \
-                AsStaticFunction_##FunctionName_<                                                    \
-                    Derived,                                                                         \
-                    decltype(Resolve<__VA_ARGS__>::func(&Derived::FunctionName_))>::value,           \
+                StaticFunction::value,                                                               \
                 #ClassName_ "::" #FunctionName_,                                                     \
                 tulip::hook::TulipConvention::Convention_                                            \
             );                                                                                       \
+            hook->setProfiledDetour(                                                                 \
+                reinterpret_cast<void*>(StaticFunction::profiledValue), &StaticFunction::profile     \
+            );                                                                                       \
             this->m_hooks[#ClassName_ "::" #FunctionName_] = hook;                                   \
         }                                                                                            \
     } while (0);
@@ -36,14 +39,18 @@
     do {                                                                                  \
         if constexpr (HasConstructor<Derived>) {                                          \
             static auto address = AddressInline_;                                         \
+            using StaticFunction = AsStaticFunction_##constructor<                        \
+                Derived, decltype(Resolve<__VA_ARGS__>::func(&Derived::constructor))>;    \
             auto hook = Hook::create(                                                     \
                 reinterpret_cast<void*>(address),                                         \
-                AsStaticFunction_##constructor<                                           \
-                    Derived,                                                              \
-                    decltype(Resolve<__VA_ARGS__>::func(&Derived::constructor))>::value,  \
+                StaticFunction::value,                                                    \
                 #ClassName_ "::" #ClassName_,                                             \
                 tulip::hook::TulipConvention::Convention_                                 \
             );                                                                            \
+            hook->setProfiledDetour(                                                      \
+                reinterpret_cast<void*>(StaticFunction::profiledValue),                   \
+                &StaticFunction::profile                                                  \
+            );                                                                            \
             this->m_hooks[#ClassName_ "::" #ClassName_] = hook;                           \
         }                                                                                 \
     } while (0);
@@ -52,12 +59,17 @@
     do {                                                                                                         \
         if constexpr (HasDestructor<Derived>) {                                                                  \
             static auto address = AddressInline_;                                                                \
+            using StaticFunction =                                                                               \
+                AsStaticFunction_##destructor<Derived, decltype(Resolve<>::func(&Derived::destructor))>;         \
             auto hook = Hook::create(                                                                            \
                 reinterpret_cast<void*>(address),                                                                \
-                AsStaticFunction_##destructor<Derived, decltype(Resolve<>::func(&Derived::destructor))>::value,  \
+                StaticFunction::value,                                                                           \
                 #ClassName_ "::" #ClassName_,                                                                    \
                 tulip::hook::TulipConvention::Convention_                                                        \
             );                                                                                                   \
+            hook->setProfiledDetour(                                                                             \
+                reinterpret_cast<void*>(StaticFunction::profiledValue), &StaticFunction::profile                 \
+            );                                                                                                   \
             this->m_hooks[#ClassName_ "::" #ClassName_] = hook;                                                  \
         }                                                                                                        \
     } while (0);
@@ -1,5 +1,10 @@
 #pragma once
 
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+
 namespace geode::cast {
 
     struct DummyClass {
@@ -56,8 +61,10 @@ namespace geode::cast {
         void* ptr, ClassTypeinfoType const* typeinfo, char const* afterIdent
     ) {
         {
+            // typeinfos are usually merged, so the names are most often the 
+            // exact same string
             auto optionIdent = typeinfo->m_typeinfoName;
-            if (std::strcmp(optionIdent, afterIdent) == 0) {
+            if (optionIdent == afterIdent || std::strcmp(optionIdent, afterIdent) == 0) {
                 return ptr;
             }
         }
@@ -100,6 +107,64 @@ namespace geode::cast {
         return traverseTypeinfoFor(basePtr, typeinfo, afterIdent);
     }
 
+    /**
+     * Cache of typeinfo_cast results for a single target type. The vtable of 
+     * an object determines both its dynamic type and which subobject the 
+     * pointer refers to, so the result of a cast is always the same offset 
+     * from the input pointer for a given vtable, or always a failure
+     */
+    template <class After>
+    struct TypeinfoCastCache {
+        static constexpr size_t SIZE = 64;
+        static constexpr intptr_t FAILED = INTPTR_MIN;
+
+        // Each slot is guarded by a sequence number that is odd while the 
+        // slot is being written. Readers never wait; a torn read is simply 
+        // treated as a miss, and writers give up if the slot is busy
+        struct Slot {
+            std::atomic<uint32_t> sequence = 0;
+            std::atomic<void*> vtable = nullptr;
+            std::atomic<intptr_t> offset = 0;
+        };
+
+        static inline Slot s_slots[SIZE];
+
+        static Slot& slotFor(void* vtable) {
+            auto key = reinterpret_cast<uintptr_t>(vtable);
+            return s_slots[((key >> 3) ^ (key >> 11)) % SIZE];
+        }
+
+        static bool find(void* vtable, intptr_t& offset) {
+            auto& slot = slotFor(vtable);
+            auto sequence = slot.sequence.load(std::memory_order_acquire);
+            if (sequence & 1) {
+                return false;
+            }
+            auto cachedVtable = slot.vtable.load(std::memory_order_relaxed);
+            auto cachedOffset = slot.offset.load(std::memory_order_relaxed);
+            std::atomic_thread_fence(std::memory_order_acquire);
+            if (slot.sequence.load(std::memory_order_relaxed) != sequence || cachedVtable != vtable) {
+                return false;
+            }
+            offset = cachedOffset;
+            return true;
+        }
+
+        static void insert(void* vtable, intptr_t offset) {
+            auto& slot = slotFor(vtable);
+            auto sequence = slot.sequence.load(std::memory_order_relaxed);
+            if ((sequence & 1) || !slot.sequence.compare_exchange_strong(
+                sequence, sequence + 1, std::memory_order_acquire, std::memory_order_relaxed
+            )) {
+                return;
+            }
+            std::atomic_thread_fence(std::memory_order_release);
+            slot.vtable.store(vtable, std::memory_order_relaxed);
+            slot.offset.store(offset, std::memory_order_relaxed);
+            slot.sequence.store(sequence + 2, std::memory_order_release);
+        }
+    };
+
     template <class After, class Before>
     inline After typeinfo_cast(Before ptr) {
         static_assert(
@@ -110,8 +175,23 @@ namespace geode::cast {
             return static_cast<After>(nullptr);
         }
 
-        auto beforeTypeinfo = reinterpret_cast<ClassTypeinfoType const*>(&typeid(std::remove_pointer_t<Before>));
-        auto afterTypeinfo = reinterpret_cast<ClassTypeinfoType const*>(&typeid(std::remove_pointer_t<After>));
-        return static_cast<After>(typeinfoCastInternal(ptr, beforeTypeinfo, afterTypeinfo, 0));
+        using Cache = TypeinfoCastCache<std::remove_cv_t<std::remove_pointer_t<After>>>;
+        void* rawPtr = ptr;
+        auto vtable = *reinterpret_cast<void**>(rawPtr);
+
+        intptr_t offset;
+        if (!Cache::find(vtable, offset)) {
+            auto beforeTypeinfo = reinterpret_cast<ClassTypeinfoType const*>(&typeid(std::remove_pointer_t<Before>));
+            auto afterTypeinfo = reinterpret_cast<ClassTypeinfoType const*>(&typeid(std::remove_pointer_t<After>));
+            auto result = typeinfoCastInternal(rawPtr, beforeTypeinfo, afterTypeinfo, 0);
+            offset = result ?
+                static_cast<std::byte*>(result) - static_cast<std::byte*>(rawPtr) :
+                Cache::FAILED;
+            Cache::insert(vtable, offset);
+        }
+        if (offset == Cache::FAILED) {
+            return static_cast<After>(nullptr);
+        }
+        return static_cast<After>(static_cast<void*>(static_cast<std::byte*>(rawPtr) + offset));
     }
 }
\ No newline at end of file
@@ -22,6 +22,34 @@ namespace geode::node_ids {
         return nullptr;
     }
 
+    /**
+     * Set the ID of the next child of type T after the one the cursor last 
+     * found
+     */
+    template <class T = CCNode>
+        requires std::is_base_of_v<CCNode, T>
+    T* setIDSafe(CCNode* node, cocos::ChildCursor& cursor, char const* id) {
+        if (auto child = cocos::getChildOfType<T>(node, cursor.index, cursor)) {
+            child->setID(id);
+            return child;
+        }
+        return nullptr;
+    }
+
+    /**
+     * Set the ID of the nth child of type T from a node's children sorted by 
+     * type beforehand
+     */
+    template <class T, class... Types>
+        requires std::is_base_of_v<CCNode, T>
+    T* setIDSafe(cocos::ChildrenByType<Types...> const& children, int index, char const* id) {
+        if (auto child = children.template get<T>(index)) {
+            child->setID(id);
+            return child;
+        }
+        return nullptr;
+    }
+
     template <typename ...Args>
     void setIDs(CCNode* node, int startIndex, Args... args) {
         for (auto i : { args... }) {
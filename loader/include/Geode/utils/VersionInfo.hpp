@@ -1,6 +1,7 @@
 #pragma once
 
 #include "../DefaultInclude.hpp"
+#include <cstdint>
 #include <string_view>
 #include <matjson.hpp>
 #include <tuple>
@@ -123,10 +124,47 @@ namespace geode {
      */
     class GEODE_DLL VersionInfo final {
     protected:
+        static constexpr uint64_t NO_KEY = ~uint64_t(0);
+
         size_t m_major = 1;
         size_t m_minor = 0;
         size_t m_patch = 0;
         std::optional<VersionTag> m_tag;
+        uint64_t m_key = computeKey(1, 0, 0, std::nullopt);
+
+        /**
+         * Pack a version into a single integer that orders the same way as
+         * comparing its fields one by one. From the top, major, minor and
+         * patch get 16 bits each, then 2 bits for the tag kind (no tag sorts
+         * last) and 14 for the tag number (no number sorts last). Versions
+         * with a component too large to fit get NO_KEY and are compared
+         * field by field instead
+         */
+        static constexpr uint64_t computeKey(
+            size_t major, size_t minor, size_t patch,
+            std::optional<VersionTag> const& tag
+        ) {
+            constexpr uint64_t FIELD_MAX = 0xffff;
+            constexpr uint64_t TAG_NUMBER_NONE = 0x3fff;
+            // major is kept below FIELD_MAX so no valid key equals NO_KEY
+            if (major >= FIELD_MAX || minor > FIELD_MAX || patch > FIELD_MAX) {
+                return NO_KEY;
+            }
+            uint64_t tagBits = (uint64_t(3) << 14) | TAG_NUMBER_NONE;
+            if (tag) {
+                if (tag->number && *tag->number >= TAG_NUMBER_NONE) {
+                    return NO_KEY;
+                }
+                tagBits = (uint64_t(tag->value) << 14) |
+                    (tag->number ? *tag->number : TAG_NUMBER_NONE);
+            }
+            return (uint64_t(major) << 48) | (uint64_t(minor) << 32) |
+                (uint64_t(patch) << 16) | tagBits;
+        }
+
+        constexpr bool hasKeyWith(VersionInfo const& other) const {
+            return m_key != NO_KEY && other.m_key != NO_KEY;
+        }
 
     public:
         constexpr VersionInfo() = default;
@@ -134,6 +172,7 @@ namespace geode {
             m_major = major;
             m_minor = minor;
             m_patch = patch;
+            m_key = computeKey(major, minor, patch, std::nullopt);
         }
         constexpr VersionInfo(
             size_t major, size_t minor, size_t patch,
@@ -143,9 +182,10 @@ namespace geode {
             m_minor = minor;
             m_patch = patch;
             m_tag = tag;
+            m_key = computeKey(major, minor, patch, tag);
         }
         
-        static Result<VersionInfo> parse(std::string const& string);
+        static Result<VersionInfo> parse(std::string_view string);
 
         constexpr size_t getMajor() const {
             return m_major;
@@ -166,22 +206,37 @@ namespace geode {
         // Apple clang does not support operator<=>! Yippee!
 
         constexpr bool operator==(VersionInfo const& other) const {
+            if (this->hasKeyWith(other)) {
+                return m_key == other.m_key;
+            }
             return std::tie(m_major, m_minor, m_patch, m_tag) ==
                 std::tie(other.m_major, other.m_minor, other.m_patch, other.m_tag);
         }
         constexpr bool operator<(VersionInfo const& other) const {
+            if (this->hasKeyWith(other)) {
+                return m_key < other.m_key;
+            }
             return std::tie(m_major, m_minor, m_patch, m_tag) <
                 std::tie(other.m_major, other.m_minor, other.m_patch, other.m_tag);
         }
         constexpr bool operator<=(VersionInfo const& other) const {
+            if (this->hasKeyWith(other)) {
+                return m_key <= other.m_key;
+            }
             return std::tie(m_major, m_minor, m_patch, m_tag) <=
                 std::tie(other.m_major, other.m_minor, other.m_patch, other.m_tag);
         }
         constexpr bool operator>(VersionInfo const& other) const {
+            if (this->hasKeyWith(other)) {
+                return m_key > other.m_key;
+            }
             return std::tie(m_major, m_minor, m_patch, m_tag) >
                 std::tie(other.m_major, other.m_minor, other.m_patch, other.m_tag);
         }
         constexpr bool operator>=(VersionInfo const& other) const {
+            if (this->hasKeyWith(other)) {
+                return m_key >= other.m_key;
+            }
             return std::tie(m_major, m_minor, m_patch, m_tag) >=
                 std::tie(other.m_major, other.m_minor, other.m_patch, other.m_tag);
         }
@@ -203,7 +258,7 @@ namespace geode {
             VersionCompare const& compare
         ) : m_version(version), m_compare(compare) {}
 
-        static Result<ComparableVersionInfo> parse(std::string const& string);
+        static Result<ComparableVersionInfo> parse(std::string_view string);
 
         constexpr bool compare(VersionInfo const& version) const {
             return compareWithReason(version) == VersionCompareResult::Match;
@@ -6,7 +6,9 @@
 #include "../DefaultInclude.hpp"
 #include <cocos2d.h>
 #include <functional>
+#include <tuple>
 #include <type_traits>
+#include <vector>
 #include "../loader/Event.hpp"
 #include "MiniFunction.hpp"
 
@@ -378,16 +380,53 @@ namespace geode {
     };
 
     class GEODE_DLL WeakRefPool final {
-        std::unordered_map<cocos2d::CCObject*, std::shared_ptr<WeakRefController>> m_pool;
+        struct Entry {
+            cocos2d::CCObject* obj = nullptr;
+            std::shared_ptr<WeakRefController> controller;
+        };
+
+        // open addressing table with linear probing, its size is always a
+        // power of two
+        std::vector<Entry> m_entries;
+        size_t m_count = 0;
+        size_t m_sweepCursor = 0;
+        size_t m_reclaimed = 0;
+        size_t m_reclaimedBySweep = 0;
+
+        size_t find(cocos2d::CCObject* obj) const;
+        void insert(cocos2d::CCObject* obj, std::shared_ptr<WeakRefController> controller);
+        void rehash(size_t capacity);
+        // releases the object in the given slot and removes it from the pool
+        void release(size_t index);
     
         void check(cocos2d::CCObject* obj);
 
         friend class WeakRefController;
 
     public:
+        struct Stats {
+            // objects currently retained by the pool
+            size_t managed;
+            // number of slots in the pool's table
+            size_t capacity;
+            // objects released by the pool since startup
+            size_t reclaimed;
+            // how many of those were found by sweep rather than by a WeakRef
+            size_t reclaimedBySweep;
+        };
+
         static WeakRefPool* get();
         
         std::shared_ptr<WeakRefController> manage(cocos2d::CCObject* obj);
+
+        /**
+         * Check a slice of the pool for objects that only the pool still
+         * holds on to, and release them. Called every frame by Geode, so
+         * that the whole pool is gone through every few frames
+         */
+        void sweep();
+
+        Stats getStats() const;
     };
 
     /**
@@ -400,11 +439,9 @@ namespace geode {
      * the pointer is still valid or not, as WeakRef::lock() returns nullptr if 
      * the pointed-to-object has already been freed.
      *
-     * Note that an object pointed to by WeakRef is only released once some 
-     * WeakRef pointing to it checks for it after all other references to the 
-     * object have been dropped. If you store WeakRefs in a global map, you may 
-     * want to periodically lock all of them to make sure any memory that should 
-     * be freed is freed.
+     * Note that an object pointed to by WeakRef is not released the moment 
+     * all other references to it are dropped, but within a few frames of it 
+     * (or as soon as some WeakRef pointing to it checks for it)
      * 
      * @tparam T A type that inherits from CCObject.
      */
@@ -628,6 +665,104 @@ namespace geode::cocos {
         return nullptr;
     }
 
+    /**
+     * Position of a getChildOfType lookup, so that a following lookup of a 
+     * later child of the same type can continue from there instead of 
+     * scanning from the first child again
+     */
+    struct ChildCursor {
+        // Index of the next child to check
+        size_t child = 0;
+        // Index among the children of the searched type of the next match
+        int index = 0;
+    };
+
+    /**
+     * Get nth child that is a given type, resuming from where a previous 
+     * lookup with the same cursor stopped. Looking up increasing indices 
+     * this way only checks each child once in total. Checks bounds.
+     * @note Each cursor should only be used for one type and one node. 
+     * Looking up an earlier or negative index restarts the search
+     * @returns Child at index cast to the given type,
+     * or nullptr if index exceeds bounds
+     */
+    template <class Type = cocos2d::CCNode>
+    static Type* getChildOfType(cocos2d::CCNode* node, int index, ChildCursor& cursor) {
+        if (index < 0) {
+            cursor = ChildCursor();
+            return getChildOfType<Type>(node, index);
+        }
+        if (index < cursor.index) {
+            cursor = ChildCursor();
+        }
+        auto count = node->getChildrenCount();
+        for (; cursor.child < count; cursor.child++) {
+            auto obj = cast::typeinfo_cast<Type*>(node->getChildren()->objectAtIndex(cursor.child));
+            if (obj != nullptr) {
+                if (cursor.index == index) {
+                    cursor.child += 1;
+                    cursor.index += 1;
+                    return obj;
+                }
+                ++cursor.index;
+            }
+        }
+        return nullptr;
+    }
+
+    /**
+     * Sorts the children of a node into lists by type in a single pass, after 
+     * which finding the nth child of any of the given types is O(1) instead 
+     * of a scan over the children like getChildOfType
+     * @note Reflects the children at the time of construction
+     * @example
+     * auto children = ChildrenByType<CCSprite, CCMenu>(layer);
+     * auto title = children.get<CCSprite>(0);
+     * auto lastMenu = children.get<CCMenu>(-1);
+     */
+    template <class... Types>
+    class ChildrenByType {
+    protected:
+        std::tuple<std::vector<Types*>...> m_children;
+
+        template <class Type>
+        void classify(cocos2d::CCObject* child) {
+            if (auto obj = cast::typeinfo_cast<Type*>(child)) {
+                std::get<std::vector<Type*>>(m_children).push_back(obj);
+            }
+        }
+
+    public:
+        explicit ChildrenByType(cocos2d::CCNode* node) {
+            auto count = node->getChildrenCount();
+            for (unsigned int i = 0; i < count; i++) {
+                auto child = node->getChildren()->objectAtIndex(i);
+                (this->classify<Types>(child), ...);
+            }
+        }
+
+        /**
+         * Get nth child of the given type. A negative index will get the 
+         * child starting from the end
+         * @returns Child at index, or nullptr if index exceeds bounds
+         */
+        template <class Type>
+        Type* get(int index) const {
+            auto& children = std::get<std::vector<Type*>>(m_children);
+            if (index < 0) index += static_cast<int>(children.size());
+            if (index < 0 || static_cast<size_t>(index) >= children.size()) return nullptr;
+            return children[index];
+        }
+
+        /**
+         * Number of children of the given type
+         */
+        template <class Type>
+        size_t count() const {
+            return std::get<std::vector<Type*>>(m_children).size();
+        }
+    };
+
     /**
      * Return a node, or create a default one if it's
      * nullptr. Syntactic sugar function
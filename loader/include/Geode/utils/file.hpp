@@ -7,6 +7,7 @@
 #include <matjson.hpp>
 #include <Geode/DefaultInclude.hpp>
 #include <ghc/fs_fwd.hpp>
+#include <span>
 #include <string>
 #include <unordered_set>
 
@@ -57,6 +58,12 @@ namespace geode::utils::file {
     class GEODE_DLL Zip final {
     public:
         using Path = ghc::filesystem::path;
+        /**
+         * Called with the number of uncompressed bytes written so far and the 
+         * total number of bytes being added
+         */
+        using Progress = utils::MiniFunction<void(size_t, size_t)>;
+        using Finished = utils::MiniFunction<void(Result<>)>;
 
     private:
         class Impl;
@@ -65,10 +72,6 @@ namespace geode::utils::file {
         Zip();
         Zip(std::unique_ptr<Impl>&& impl);
 
-        Result<> addAllFromRecurse(
-            Path const& dir, Path const& entry
-        );
-
         // for sharing Impl
         friend class Unzip;
     
@@ -96,13 +99,20 @@ namespace geode::utils::file {
 
         /**
          * Get the zipped data
+         * @note Returns nothing while an asynchronous add is running
          */
         ByteVector getData() const;
 
         /**
-         * Add an entry to the zip with data
+         * Add an entry to the zip with data. Large entries are split into 
+         * blocks that are compressed in parallel
          */
         Result<> add(Path const& entry, ByteVector const& data);
+        /**
+         * Add an entry to the zip with data. Unlike the copying overload, 
+         * large entries are compressed without making a copy of the data
+         */
+        Result<> add(Path const& entry, ByteVector&& data);
         /**
          * Add an entry to the zip with string data
          */
@@ -127,8 +137,43 @@ namespace geode::utils::file {
          * @param entry Folder path in zip
          */
         Result<> addFolder(Path const& entry);
+        /**
+         * Add multiple entries to the zip at once. The entries are compressed 
+         * in parallel on a pool of worker threads and written in order, which 
+         * is much faster than calling Zip::add for each of them
+         * @param entries Pairs of entry paths and their data
+         */
+        Result<> addAll(std::vector<std::pair<Path, ByteVector>> entries);
+        /**
+         * Like Zip::addAll, but runs on a background thread instead of 
+         * blocking the calling one. Until `then` has been called, every other 
+         * operation on the zip fails, and destroying the zip waits for the 
+         * write to finish
+         * @param entries Pairs of entry paths and their data
+         * @param then Called on the main thread once all entries have been 
+         * written or writing has failed
+         * @param progress Called on the main thread as entries are written
+         */
+        void addAllAsync(
+            std::vector<std::pair<Path, ByteVector>> entries,
+            Finished then, Progress progress = nullptr
+        );
+        /**
+         * Like Zip::addAllFrom, but runs on a background thread. See 
+         * Zip::addAllAsync for how the zip behaves until it's finished
+         * @param dir Directory on disk
+         * @param then Called on the main thread once all entries have been 
+         * written or writing has failed
+         * @param progress Called on the main thread as entries are written
+         */
+        void addAllFromAsync(Path const& dir, Finished then, Progress progress = nullptr);
     };
 
+    /**
+     * Reads zips. Zips on disk are memory-mapped, and the entry list is read 
+     * once when the zip is opened, after which entries can be looked up in 
+     * constant time and extracted from multiple threads at once
+     */
     class GEODE_DLL Unzip final {
     private:
         using Impl = Zip::Impl;
@@ -153,6 +198,11 @@ namespace geode::utils::file {
          * Create unzipper for data in-memory
          */
         static Result<Unzip> create(ByteVector const& data);
+        /**
+         * Create unzipper for data in-memory, taking ownership of the data 
+         * instead of copying it
+         */
+        static Result<Unzip> create(ByteVector&& data);
 
         /**
          * Path to the opened zip
@@ -176,6 +226,15 @@ namespace geode::utils::file {
          * @param name Entry path in zip
          */
         Result<ByteVector> extract(Path const& name);
+        /**
+         * Get an entry's data without copying or extracting it. Only works 
+         * for entries that are stored without compression; use 
+         * Unzip::extract for the rest
+         * @param name Entry path in zip
+         * @returns A view into the zip that's valid for as long as this 
+         * Unzip is alive
+         */
+        Result<std::span<uint8_t const>> view(Path const& name) const;
         /**
          * Extract entry to file
          * @param name Entry path in zip
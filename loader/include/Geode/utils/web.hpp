@@ -60,6 +60,7 @@ namespace geode::utils::web {
     using AsyncExpectCode = utils::MiniFunction<void(std::string const&, int)>;
     using AsyncThen = utils::MiniFunction<void(SentAsyncWebRequest&, ByteVector const&)>;
     using AsyncCancelled = utils::MiniFunction<void(SentAsyncWebRequest&)>;
+    using AsyncChunk = utils::MiniFunction<void(void const*, size_t)>;
 
     /**
      * A handle to an in-progress sent asynchronous web request. Use this to
@@ -225,6 +226,16 @@ namespace geode::utils::web {
          * Specify a timeout, in seconds, in which the request will fail.
          */
         AsyncWebRequest& timeout(std::chrono::seconds seconds);
+        /**
+         * Resume a download into a file instead of starting over. If the 
+         * target file already exists, only the rest of it is requested using 
+         * an HTTP Range request and appended to the file; if the server 
+         * doesn't support ranges, the file is downloaded from the start. The 
+         * partial file is kept if the request fails or is cancelled, so a 
+         * later request can pick up where this one stopped. Has no effect 
+         * unless downloading into a file
+         */
+        AsyncWebRequest& resumable(bool resumable = true);
 
         // Callbacks
 
@@ -259,6 +270,18 @@ namespace geode::utils::web {
          * @returns Same AsyncWebRequest
          */
         AsyncWebRequest& cancelled(AsyncCancelled handler);
+        /**
+         * Specify a callback that receives the response body piece by piece 
+         * as it is downloaded, in addition to it being written to the 
+         * target. Unlike the other callbacks, this one runs on the request's 
+         * own thread, so it must not touch the UI; it's meant for things 
+         * like hashing a download while it arrives. If this request is 
+         * joined to one that is already running, data received before 
+         * joining is not replayed
+         * @param handler Callback to run for each received piece of data
+         * @returns Same AsyncWebRequest
+         */
+        AsyncWebRequest& chunk(AsyncChunk handler);
     };
 
     template <class T>
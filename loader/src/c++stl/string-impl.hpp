@@ -20,5 +20,10 @@ namespace geode::stl {
 
         size_t getCapacity();
         void setCapacity(size_t);
+
+        // makes sure the storage can hold at least cap characters and isn't 
+        // shared with any other string, so it can be written to in place. 
+        // keeps the current contents
+        void reserve(size_t cap);
     };
 }
\ No newline at end of file
@@ -1,6 +1,9 @@
 #include <Geode/c++stl/gdstdlib.hpp>
 #include "string-impl.hpp"
+#include <algorithm>
 #include <compare>
+#include <cstring>
+#include <functional>
 #include <stdexcept>
 
 template <class Type>
@@ -13,6 +16,17 @@ using geode::stl::StringImpl;
 #define implFor(x) StringImpl{intoMutRef(x.m_data)}
 #define impl implFor((*this))
 
+#ifndef GEODE_IS_MACOS
+namespace {
+    // make room for size characters, growing geometrically so that repeated 
+    // appends don't reallocate every time
+    void growTo(StringImpl str, size_t size) {
+        auto cap = str.getCapacity();
+        str.reserve(size > cap ? std::max(size, cap * 2) : size);
+    }
+}
+#endif
+
 namespace gd {
 #ifndef GEODE_IS_MACOS
     string::string() {
@@ -23,12 +37,13 @@ namespace gd {
         impl.setStorage(str);
     }
 
-    // string::string(string&& other) {
-    //     // TODO: do this better :-)
-    //     impl.setStorage(other);
-    //     implFor(other).free();
-    //     implFor(other).setEmpty();
-    // }
+    string::string(string&& other) noexcept {
+        // both layouts can be moved by just taking over the other string's 
+        // representation: msvc's small buffer lives inline in m_data, and 
+        // gnustl's representation is behind a pointer
+        m_data = other.m_data;
+        implFor(other).setEmpty();
+    }
 
     string::string(char const* str) {
         impl.setStorage(str);
@@ -38,6 +53,10 @@ namespace gd {
         impl.setStorage(str);
     }
 
+    string::string(std::string_view str) {
+        impl.setStorage(str);
+    }
+
     string::~string() {
         this->clear();
     }
@@ -49,12 +68,12 @@ namespace gd {
         }
         return *this;
     }
-    string& string::operator=(string&& other) {
-        // TODO: do this better :-)
-        impl.free();
-        impl.setStorage(other);
-        implFor(other).free();
-        implFor(other).setEmpty();
+    string& string::operator=(string&& other) noexcept {
+        if (this != &other) {
+            impl.free();
+            m_data = other.m_data;
+            implFor(other).setEmpty();
+        }
         return *this;
     }
     string& string::operator=(char const* other) {
@@ -67,11 +86,58 @@ namespace gd {
         impl.setStorage(other);
         return *this;
     }
+    string& string::operator=(std::string_view other) {
+        // other may point into this string, so it can't be freed first
+        string copy(other);
+        return *this = std::move(copy);
+    }
 
     void string::clear() {
         impl.free();
         impl.setEmpty();
     }
+
+    void string::reserve(size_t cap) {
+        impl.reserve(cap);
+    }
+
+    void string::resize(size_t size, char ch) {
+        auto oldSize = this->size();
+        growTo(impl, size);
+        if (size > oldSize) {
+            std::memset(impl.getStorage() + oldSize, ch, size - oldSize);
+        }
+        impl.setSize(size);
+        impl.getStorage()[size] = 0;
+    }
+
+    string& string::append(std::string_view str) {
+        auto size = this->size();
+        // str may point into this string, in which case growing would leave 
+        // it dangling
+        auto storage = impl.getStorage();
+        auto aliased = std::greater_equal<>()(str.data(), storage) &&
+            std::less<>()(str.data(), storage + size);
+        auto offset = aliased ? str.data() - storage : 0;
+
+        growTo(impl, size + str.size());
+        storage = impl.getStorage();
+        if (aliased) {
+            str = std::string_view(storage + offset, str.size());
+        }
+        std::memcpy(storage + size, str.data(), str.size());
+        impl.setSize(size + str.size());
+        storage[size + str.size()] = 0;
+        return *this;
+    }
+
+    void string::push_back(char ch) {
+        auto size = this->size();
+        growTo(impl, size + 1);
+        impl.getStorage()[size] = ch;
+        impl.setSize(size + 1);
+        impl.getStorage()[size + 1] = 0;
+    }
     
     char& string::at(size_t pos) {
         if (pos >= this->size())
@@ -32,17 +32,38 @@
 #include <../support/zip_support/ioapi.h>
 #include <../support/zip_support/unzip.h>
 #include <Geode/c++stl/gdstdlib.hpp>
+#include <algorithm>
 #include <assert.h>
+#include <climits>
 #include <ccMacros.h>
+#include <cstring>
 #include <map>
+#include <memory>
 #include <stdlib.h>
 
+#if defined(__AVX2__)
+    #define GEODE_B64_AVX2
+    #include <immintrin.h>
+#elif defined(__SSSE3__) || defined(__AVX__)
+    #define GEODE_B64_SSSE3
+    #include <tmmintrin.h>
+#elif defined(__aarch64__) || defined(_M_ARM64)
+    #define GEODE_B64_NEON
+    #include <arm_neon.h>
+#endif
+
 NS_CC_BEGIN
 
 unsigned int ZipUtils::s_uEncryptedPvrKeyParts[4] = { 0, 0, 0, 0 };
 unsigned int ZipUtils::s_uEncryptionKey[1024];
 bool ZipUtils::s_bEncryptionKeyIsValid = false;
 
+// Largest decompressed size trusted from a gzip trailer relative to the
+// compressed size, which is about the most deflate can shrink anything;
+// anything beyond is treated as corrupt and the output buffer is grown on
+// demand instead
+static constexpr size_t MAX_TRUSTED_RATIO = 1032;
+
 // --------------------- ZipUtils ---------------------
 
 inline void ZipUtils::ccDecodeEncodedPvr(unsigned int* data, int len) {
@@ -228,6 +249,18 @@ int ZipUtils::ccInflateMemoryWithHint(
 }
 
 int ZipUtils::ccInflateMemory(unsigned char* in, unsigned int inLength, unsigned char** out) {
+    // gzip streams store the uncompressed size in their trailer, so use that 
+    // instead of guessing and reallocating
+    if (inLength >= 18 && in[0] == 0x1f && in[1] == 0x8b) {
+        unsigned char* trailer = in + inLength - 4;
+        unsigned int size = trailer[0] | (trailer[1] << 8) | (trailer[2] << 16) |
+            ((unsigned int)trailer[3] << 24);
+        // the hint is passed on as an int, so a corrupt trailer mustn't 
+        // overflow it
+        if (size > 0 && size <= INT_MAX - 1 && size / MAX_TRUSTED_RATIO <= inLength) {
+            return ccInflateMemoryWithHint(in, inLength, out, size + 1);
+        }
+    }
     // 256k for hint
     return ccInflateMemoryWithHint(in, inLength, out, 256 * 1024);
 }
@@ -417,6 +450,481 @@ void ZipUtils::ccSetPvrEncryptionKey(
     ccSetPvrEncryptionKeyPart(3, keyPart4);
 }
 
+// --------------------- Geode additions: fast codec ---------------------
+
+namespace {
+    constexpr uint8_t B64_INVALID = 0xff;
+
+    struct Base64Table {
+        uint8_t values[256];
+
+        constexpr Base64Table() : values() {
+            for (auto& v : values) {
+                v = B64_INVALID;
+            }
+            for (int i = 0; i < 26; i++) {
+                values['A' + i] = static_cast<uint8_t>(i);
+                values['a' + i] = static_cast<uint8_t>(26 + i);
+            }
+            for (int i = 0; i < 10; i++) {
+                values['0' + i] = static_cast<uint8_t>(52 + i);
+            }
+            values['+'] = values['-'] = 62;
+            values['/'] = values['_'] = 63;
+        }
+    };
+    constexpr Base64Table B64_TABLE {};
+
+    // The SIMD decoders may write up to this many bytes past the end of the
+    // decoded output, so output buffers are allocated with this much slack
+    constexpr size_t B64_OUTPUT_SLACK = 32;
+
+    // Decodes as many whole 4-char groups as possible with the scalar table,
+    // stopping at the first invalid character. Returns the number of chars
+    // consumed
+    size_t base64DecodeScalar(uint8_t const* in, size_t len, uint8_t*& out) {
+        size_t i = 0;
+        for (; i + 4 <= len; i += 4) {
+            uint32_t a = B64_TABLE.values[in[i]];
+            uint32_t b = B64_TABLE.values[in[i + 1]];
+            uint32_t c = B64_TABLE.values[in[i + 2]];
+            uint32_t d = B64_TABLE.values[in[i + 3]];
+            if ((a | b | c | d) & 0xc0) {
+                break;
+            }
+            uint32_t n = (a << 18) | (b << 12) | (c << 6) | d;
+            out[0] = static_cast<uint8_t>(n >> 16);
+            out[1] = static_cast<uint8_t>(n >> 8);
+            out[2] = static_cast<uint8_t>(n);
+            out += 3;
+        }
+        return i;
+    }
+
+#if defined(GEODE_B64_AVX2) || defined(GEODE_B64_SSSE3)
+    // Translates 16 chars to their 6-bit values using range compares, which
+    // lets both alphabets through without a lookup table. Returns false if
+    // any char is not base64
+    inline bool base64TranslateSSE(__m128i& v) {
+        auto between = [&](char lo, char hi) {
+            return _mm_and_si128(
+                _mm_cmpgt_epi8(v, _mm_set1_epi8(lo - 1)),
+                _mm_cmplt_epi8(v, _mm_set1_epi8(hi + 1))
+            );
+        };
+        auto upper = between('A', 'Z');
+        auto lower = between('a', 'z');
+        auto digit = between('0', '9');
+        auto plus = _mm_or_si128(
+            _mm_cmpeq_epi8(v, _mm_set1_epi8('+')), _mm_cmpeq_epi8(v, _mm_set1_epi8('-'))
+        );
+        auto slash = _mm_or_si128(
+            _mm_cmpeq_epi8(v, _mm_set1_epi8('/')), _mm_cmpeq_epi8(v, _mm_set1_epi8('_'))
+        );
+        auto valid = _mm_or_si128(
+            _mm_or_si128(upper, lower), _mm_or_si128(_mm_or_si128(digit, plus), slash)
+        );
+        if (_mm_movemask_epi8(valid) != 0xffff) {
+            return false;
+        }
+        v = _mm_or_si128(
+            _mm_or_si128(
+                _mm_and_si128(upper, _mm_sub_epi8(v, _mm_set1_epi8('A'))),
+                _mm_and_si128(lower, _mm_sub_epi8(v, _mm_set1_epi8('a' - 26)))
+            ),
+            _mm_or_si128(
+                _mm_and_si128(digit, _mm_add_epi8(v, _mm_set1_epi8(52 - '0'))),
+                _mm_or_si128(
+                    _mm_and_si128(plus, _mm_set1_epi8(62)), _mm_and_si128(slash, _mm_set1_epi8(63))
+                )
+            )
+        );
+        return true;
+    }
+#endif
+
+#if defined(GEODE_B64_AVX2)
+    inline bool base64TranslateAVX2(__m256i& v) {
+        auto between = [&](char lo, char hi) {
+            return _mm256_and_si256(
+                _mm256_cmpgt_epi8(v, _mm256_set1_epi8(lo - 1)),
+                _mm256_cmpgt_epi8(_mm256_set1_epi8(hi + 1), v)
+            );
+        };
+        auto upper = between('A', 'Z');
+        auto lower = between('a', 'z');
+        auto digit = between('0', '9');
+        auto plus = _mm256_or_si256(
+            _mm256_cmpeq_epi8(v, _mm256_set1_epi8('+')), _mm256_cmpeq_epi8(v, _mm256_set1_epi8('-'))
+        );
+        auto slash = _mm256_or_si256(
+            _mm256_cmpeq_epi8(v, _mm256_set1_epi8('/')), _mm256_cmpeq_epi8(v, _mm256_set1_epi8('_'))
+        );
+        auto valid = _mm256_or_si256(
+            _mm256_or_si256(upper, lower), _mm256_or_si256(_mm256_or_si256(digit, plus), slash)
+        );
+        if (_mm256_movemask_epi8(valid) != -1) {
+            return false;
+        }
+        v = _mm256_or_si256(
+            _mm256_or_si256(
+                _mm256_and_si256(upper, _mm256_sub_epi8(v, _mm256_set1_epi8('A'))),
+                _mm256_and_si256(lower, _mm256_sub_epi8(v, _mm256_set1_epi8('a' - 26)))
+            ),
+            _mm256_or_si256(
+                _mm256_and_si256(digit, _mm256_add_epi8(v, _mm256_set1_epi8(52 - '0'))),
+                _mm256_or_si256(
+                    _mm256_and_si256(plus, _mm256_set1_epi8(62)),
+                    _mm256_and_si256(slash, _mm256_set1_epi8(63))
+                )
+            )
+        );
+        return true;
+    }
+#endif
+
+#if defined(GEODE_B64_NEON)
+    inline bool base64TranslateNEON(uint8x16_t& v) {
+        auto between = [&](uint8_t lo, uint8_t hi) {
+            return vandq_u8(vcgeq_u8(v, vdupq_n_u8(lo)), vcleq_u8(v, vdupq_n_u8(hi)));
+        };
+        auto upper = between('A', 'Z');
+        auto lower = between('a', 'z');
+        auto digit = between('0', '9');
+        auto plus = vorrq_u8(vceqq_u8(v, vdupq_n_u8('+')), vceqq_u8(v, vdupq_n_u8('-')));
+        auto slash = vorrq_u8(vceqq_u8(v, vdupq_n_u8('/')), vceqq_u8(v, vdupq_n_u8('_')));
+        auto valid = vorrq_u8(vorrq_u8(upper, lower), vorrq_u8(vorrq_u8(digit, plus), slash));
+        if (vminvq_u8(valid) != 0xff) {
+            return false;
+        }
+        v = vorrq_u8(
+            vorrq_u8(
+                vandq_u8(upper, vsubq_u8(v, vdupq_n_u8('A'))),
+                vandq_u8(lower, vsubq_u8(v, vdupq_n_u8('a' - 26)))
+            ),
+            vorrq_u8(
+                vandq_u8(digit, vaddq_u8(v, vdupq_n_u8(52 - '0'))),
+                vorrq_u8(vandq_u8(plus, vdupq_n_u8(62)), vandq_u8(slash, vdupq_n_u8(63)))
+            )
+        );
+        return true;
+    }
+#endif
+
+    // Decodes whole 4-char groups, using the widest vector path available
+    // and finishing with the scalar decoder. Returns the number of chars
+    // consumed, which is less than len only if an invalid char was found
+    size_t base64DecodeGroups(uint8_t const* in, size_t len, uint8_t*& out) {
+        size_t i = 0;
+#if defined(GEODE_B64_AVX2)
+        for (; i + 32 <= len; i += 32) {
+            auto v = _mm256_loadu_si256(reinterpret_cast<__m256i const*>(in + i));
+            if (!base64TranslateAVX2(v)) break;
+            auto merged = _mm256_maddubs_epi16(v, _mm256_set1_epi32(0x01400140));
+            merged = _mm256_madd_epi16(merged, _mm256_set1_epi32(0x00011000));
+            merged = _mm256_shuffle_epi8(merged, _mm256_setr_epi8(
+                2, 1, 0, 6, 5, 4, 10, 9, 8, 14, 13, 12, -1, -1, -1, -1,
+                2, 1, 0, 6, 5, 4, 10, 9, 8, 14, 13, 12, -1, -1, -1, -1
+            ));
+            merged = _mm256_permutevar8x32_epi32(merged, _mm256_setr_epi32(0, 1, 2, 4, 5, 6, 3, 7));
+            _mm256_storeu_si256(reinterpret_cast<__m256i*>(out), merged);
+            out += 24;
+        }
+#endif
+#if defined(GEODE_B64_AVX2) || defined(GEODE_B64_SSSE3)
+        for (; i + 16 <= len; i += 16) {
+            auto v = _mm_loadu_si128(reinterpret_cast<__m128i const*>(in + i));
+            if (!base64TranslateSSE(v)) break;
+            auto merged = _mm_maddubs_epi16(v, _mm_set1_epi32(0x01400140));
+            merged = _mm_madd_epi16(merged, _mm_set1_epi32(0x00011000));
+            merged = _mm_shuffle_epi8(merged, _mm_setr_epi8(
+                2, 1, 0, 6, 5, 4, 10, 9, 8, 14, 13, 12, -1, -1, -1, -1
+            ));
+            _mm_storeu_si128(reinterpret_cast<__m128i*>(out), merged);
+            out += 12;
+        }
+#endif
+#if defined(GEODE_B64_NEON)
+        for (; i + 64 <= len; i += 64) {
+            auto v = vld4q_u8(in + i);
+            if (
+                !base64TranslateNEON(v.val[0]) || !base64TranslateNEON(v.val[1]) ||
+                !base64TranslateNEON(v.val[2]) || !base64TranslateNEON(v.val[3])
+            ) break;
+            uint8x16x3_t res;
+            res.val[0] = vorrq_u8(vshlq_n_u8(v.val[0], 2), vshrq_n_u8(v.val[1], 4));
+            res.val[1] = vorrq_u8(vshlq_n_u8(v.val[1], 4), vshrq_n_u8(v.val[2], 2));
+            res.val[2] = vorrq_u8(vshlq_n_u8(v.val[2], 6), v.val[3]);
+            vst3q_u8(out, res);
+            out += 48;
+        }
+#endif
+        return i + base64DecodeScalar(in + i, len - i, out);
+    }
+
+    // Decodes the final 2 or 3 chars of an unpadded string
+    bool base64DecodeTail(uint8_t const* in, size_t len, uint8_t*& out) {
+        if (len == 0) return true;
+        if (len == 1) return false;
+        uint32_t n = 0;
+        for (size_t i = 0; i < 4; i++) {
+            uint32_t v = i < len ? B64_TABLE.values[in[i]] : 0;
+            if (v == B64_INVALID) return false;
+            n = (n << 6) | v;
+        }
+        *out++ = static_cast<uint8_t>(n >> 16);
+        if (len == 3) {
+            *out++ = static_cast<uint8_t>(n >> 8);
+        }
+        return true;
+    }
+
+    // Streams base64 text through an optional XOR decrypt and decoder in
+    // fixed-size blocks, so callers can consume the decoded bytes without
+    // the whole decoded string ever existing in memory
+    class Base64Reader {
+        static constexpr size_t BLOCK_CHARS = 64 * 1024;
+
+        std::string_view m_data;
+        size_t m_pos = 0;
+        bool m_xor;
+        uint8_t m_key;
+        std::unique_ptr<uint8_t[]> m_xorBuffer;
+        std::unique_ptr<uint8_t[]> m_buffer;
+        bool m_failed = false;
+
+        // Reads the (decrypted) char at the given index
+        uint8_t at(size_t index) const {
+            auto c = static_cast<uint8_t>(m_data[index]);
+            return m_xor ? c ^ m_key : c;
+        }
+
+    public:
+        Base64Reader(std::string_view data, bool isEncrypted, int key)
+          : m_data(data), m_xor(isEncrypted), m_key(static_cast<uint8_t>(key)) {
+            // Strip padding
+            for (size_t i = 0; i < 2 && !m_data.empty() && at(m_data.size() - 1) == '='; i++) {
+                m_data.remove_suffix(1);
+            }
+            if (m_xor) {
+                m_xorBuffer.reset(new uint8_t[BLOCK_CHARS]);
+            }
+            m_buffer.reset(new uint8_t[BLOCK_CHARS / 4 * 3 + B64_OUTPUT_SLACK]);
+        }
+
+        // Exact number of bytes the whole string decodes to
+        size_t decodedSize() const {
+            return m_data.size() / 4 * 3 + (m_data.size() % 4 ? m_data.size() % 4 - 1 : 0);
+        }
+
+        bool failed() const {
+            return m_failed;
+        }
+
+        bool done() const {
+            return m_pos >= m_data.size();
+        }
+
+        // Decodes `count` bytes starting at decoded offset `offset` without
+        // moving the stream, used for peeking at headers and trailers
+        bool peek(size_t offset, uint8_t* out, size_t count) const {
+            if (offset + count > this->decodedSize()) return false;
+            auto first = offset / 3 * 4;
+            auto last = std::min((offset + count + 2) / 3 * 4, m_data.size());
+            uint8_t chars[16];
+            uint8_t decoded[12 + B64_OUTPUT_SLACK];
+            if (last - first > sizeof(chars)) return false;
+            for (auto i = first; i < last; i++) {
+                chars[i - first] = this->at(i);
+            }
+            auto whole = (last - first) / 4 * 4;
+            auto ptr = decoded;
+            if (base64DecodeScalar(chars, whole, ptr) != whole) return false;
+            if (!base64DecodeTail(chars + whole, last - first - whole, ptr)) return false;
+            std::memcpy(out, decoded + (offset - first / 4 * 3), count);
+            return true;
+        }
+
+        // Decodes the next block. The returned span is valid until the next
+        // call; an empty span means either the end or an error
+        std::pair<uint8_t const*, size_t> next() {
+            if (m_failed || this->done()) return { nullptr, 0 };
+            auto len = std::min(BLOCK_CHARS, m_data.size() - m_pos);
+            auto in = reinterpret_cast<uint8_t const*>(m_data.data() + m_pos);
+            if (m_xor) {
+                for (size_t i = 0; i < len; i++) {
+                    m_xorBuffer[i] = in[i] ^ m_key;
+                }
+                in = m_xorBuffer.get();
+            }
+            m_pos += len;
+
+            auto out = m_buffer.get();
+            auto whole = len / 4 * 4;
+            if (base64DecodeGroups(in, whole, out) != whole) {
+                m_failed = true;
+                return { nullptr, 0 };
+            }
+            if (!base64DecodeTail(in + whole, len - whole, out)) {
+                m_failed = true;
+                return { nullptr, 0 };
+            }
+            return { m_buffer.get(), static_cast<size_t>(out - m_buffer.get()) };
+        }
+    };
+
+    void base64EncodeTo(
+        uint8_t const* in, size_t len, char* out, bool urlSafe, bool isEncrypted, uint8_t key
+    ) {
+        static constexpr char STANDARD[] =
+            "ABCDEFGHIJKLMNOPQRSTUVWXYZabcdefghijklmnopqrstuvwxyz0123456789+/";
+        static constexpr char URL_SAFE[] =
+            "ABCDEFGHIJKLMNOPQRSTUVWXYZabcdefghijklmnopqrstuvwxyz0123456789-_";
+        auto alphabet = urlSafe ? URL_SAFE : STANDARD;
+        auto mask = isEncrypted ? key : 0;
+
+        size_t i = 0;
+        for (; i + 3 <= len; i += 3) {
+            uint32_t n = (in[i] << 16) | (in[i + 1] << 8) | in[i + 2];
+            out[0] = alphabet[(n >> 18) & 63] ^ mask;
+            out[1] = alphabet[(n >> 12) & 63] ^ mask;
+            out[2] = alphabet[(n >> 6) & 63] ^ mask;
+            out[3] = alphabet[n & 63] ^ mask;
+            out += 4;
+        }
+        if (i < len) {
+            uint32_t n = in[i] << 16;
+            if (i + 1 < len) {
+                n |= in[i + 1] << 8;
+            }
+            out[0] = alphabet[(n >> 18) & 63] ^ mask;
+            out[1] = alphabet[(n >> 12) & 63] ^ mask;
+            out[2] = (i + 1 < len ? alphabet[(n >> 6) & 63] : '=') ^ mask;
+            out[3] = '=' ^ mask;
+        }
+    }
+}
+
+bool ZipUtils::base64Decode(std::string_view data, std::string& out) {
+    for (size_t i = 0; i < 2 && !data.empty() && data.back() == '='; i++) {
+        data.remove_suffix(1);
+    }
+    auto in = reinterpret_cast<uint8_t const*>(data.data());
+    auto whole = data.size() / 4 * 4;
+
+    out.resize(whole / 4 * 3 + 2 + B64_OUTPUT_SLACK);
+    auto begin = reinterpret_cast<uint8_t*>(out.data());
+    auto ptr = begin;
+    if (
+        base64DecodeGroups(in, whole, ptr) != whole ||
+        !base64DecodeTail(in + whole, data.size() - whole, ptr)
+    ) {
+        out.clear();
+        return false;
+    }
+    out.resize(ptr - begin);
+    return true;
+}
+
+std::string ZipUtils::base64Encode(std::string_view data, bool urlSafe) {
+    std::string out;
+    out.resize((data.size() + 2) / 3 * 4);
+    base64EncodeTo(
+        reinterpret_cast<uint8_t const*>(data.data()), data.size(), out.data(), urlSafe, false, 0
+    );
+    return out;
+}
+
+std::string ZipUtils::decompressStringFast(std::string_view data, bool isEncrypted, int key) {
+    Base64Reader reader(data, isEncrypted, key);
+    auto compressedSize = reader.decodedSize();
+
+    // Gzip streams record the uncompressed size (mod 2^32) in their last 4
+    // bytes, which lets us inflate into an exactly sized buffer
+    size_t outSize = std::max<size_t>(compressedSize * 4, 1024);
+    uint8_t header[2];
+    uint8_t trailer[4];
+    if (
+        compressedSize >= 18 &&
+        reader.peek(0, header, 2) && header[0] == 0x1f && header[1] == 0x8b &&
+        reader.peek(compressedSize - 4, trailer, 4)
+    ) {
+        size_t isize = trailer[0] | (trailer[1] << 8) | (trailer[2] << 16) |
+            (static_cast<uint32_t>(trailer[3]) << 24);
+        if (isize <= compressedSize * MAX_TRUSTED_RATIO) {
+            // One spare byte so a correct size doesn't end in Z_BUF_ERROR
+            outSize = isize + 1;
+        }
+    }
+
+    std::string out;
+    out.resize(outSize);
+
+    z_stream stream {};
+    stream.next_out = reinterpret_cast<Bytef*>(out.data());
+    stream.avail_out = static_cast<uInt>(out.size());
+    if (inflateInit2(&stream, 15 + 32) != Z_OK) {
+        return "";
+    }
+
+    int err = Z_OK;
+    while (err != Z_STREAM_END) {
+        if (stream.avail_out == 0) {
+            auto written = out.size();
+            out.resize(written * 2);
+            stream.next_out = reinterpret_cast<Bytef*>(out.data() + written);
+            stream.avail_out = static_cast<uInt>(out.size() - written);
+        }
+        if (stream.avail_in == 0 && !reader.done()) {
+            auto [block, size] = reader.next();
+            if (!size) break;
+            stream.next_in = const_cast<Bytef*>(block);
+            stream.avail_in = static_cast<uInt>(size);
+        }
+        err = inflate(&stream, Z_NO_FLUSH);
+        // Z_BUF_ERROR with room left in the output means the input ran out
+        // before the end of the stream
+        if (err == Z_BUF_ERROR && stream.avail_out != 0) {
+            break;
+        }
+        if (err != Z_OK && err != Z_STREAM_END && err != Z_BUF_ERROR) {
+            break;
+        }
+    }
+    inflateEnd(&stream);
+
+    if (err != Z_STREAM_END || reader.failed()) {
+        return "";
+    }
+    out.resize(stream.total_out);
+    return out;
+}
+
+std::string ZipUtils::compressStringFast(std::string_view data, bool isEncrypted, int key) {
+    z_stream stream {};
+    if (deflateInit2(&stream, Z_DEFAULT_COMPRESSION, Z_DEFLATED, 15 + 16, 8, Z_DEFAULT_STRATEGY) != Z_OK) {
+        return "";
+    }
+    auto bound = deflateBound(&stream, static_cast<uLong>(data.size()));
+    auto compressed = std::make_unique<uint8_t[]>(bound);
+
+    stream.next_in = reinterpret_cast<Bytef*>(const_cast<char*>(data.data()));
+    stream.avail_in = static_cast<uInt>(data.size());
+    stream.next_out = compressed.get();
+    stream.avail_out = static_cast<uInt>(bound);
+    auto err = deflate(&stream, Z_FINISH);
+    auto size = stream.total_out;
+    deflateEnd(&stream);
+    if (err != Z_STREAM_END) {
+        return "";
+    }
+
+    std::string out;
+    out.resize((size + 2) / 3 * 4);
+    base64EncodeTo(compressed.get(), size, out.data(), true, isEncrypted, static_cast<uint8_t>(key));
+    return out;
+}
+
 // --------------------- ZipFile ---------------------
 // from unzip.cpp
 #define UNZ_MAXFILENAMEINZIP 256
@@ -4,6 +4,7 @@
 #include <array>
 #include <fmt/format.h>
 #include <loader/LoaderImpl.hpp>
+#include <internal/Tracer.hpp>
 #include <loader/console.hpp>
 #include <loader/updater.hpp>
 #include <Geode/utils/NodeIDs.hpp>
@@ -16,6 +17,7 @@ struct CustomLoadingLayer : Modify<CustomLoadingLayer, LoadingLayer> {
     CCLabelBMFont* m_smallLabel2 = nullptr;
     int m_geodeLoadStep = 0;
     int m_totalMods = 0;
+    bool m_modResourcesQueued = false;
 
     static void onModify(auto& self) {
         if (!self.setHookPriority("LoadingLayer::init", geode::node_ids::GEODE_ID_PRIORITY)) {
@@ -141,10 +143,22 @@ struct CustomLoadingLayer : Modify<CustomLoadingLayer, LoadingLayer> {
     }
 
     void setupModResources() {
-        log::debug("Loading mod resources");
-        this->setSmallText("Loading mod resources");
-        LoaderImpl::get()->updateResources(true);
-        this->continueLoadAssets();
+        // the spritesheets are decoded in the background, and only uploaded
+        // here for a limited time each frame so the loading bar keeps moving
+        static constexpr auto UPLOAD_BUDGET = std::chrono::milliseconds(8);
+
+        if (!m_fields->m_modResourcesQueued) {
+            log::debug("Loading mod resources");
+            this->setSmallText("Loading mod resources");
+            LoaderImpl::get()->queueResources(true);
+            m_fields->m_modResourcesQueued = true;
+        }
+        if (LoaderImpl::get()->uploadQueuedResources(UPLOAD_BUDGET)) {
+            this->continueLoadAssets();
+        }
+        else {
+            this->waitLoadAssets();
+        }
     }
     
     int getCurrentStep() {
@@ -182,6 +196,11 @@ struct CustomLoadingLayer : Modify<CustomLoadingLayer, LoadingLayer> {
 
     // hook
     void loadAssets() {
+        static constexpr std::array<char const*, 4> STEP_NAMES = {
+            "Loading mods", "Loader resources", "Mod resources", "Game resources"
+        };
+        TraceSpan span(STEP_NAMES[std::min<size_t>(m_fields->m_geodeLoadStep, STEP_NAMES.size() - 1)]);
+
         switch (m_fields->m_geodeLoadStep) {
         case 0:
             if (this->skipOnRefresh()) this->setupLoadingMods();
@@ -13,6 +13,7 @@
 #include <loader/ModImpl.hpp>
 #include <loader/LoaderImpl.hpp>
 #include <loader/updater.hpp>
+#include <internal/Tracer.hpp>
 #include <Geode/binding/ButtonSprite.hpp>
 
 using namespace geode::prelude;
@@ -58,6 +59,9 @@ struct CustomMenuLayer : Modify<CustomMenuLayer, MenuLayer> {
     bool init() {
         if (!MenuLayer::init()) return false;
 
+        // startup is over once the main menu shows up
+        Tracer::get()->finishStartup();
+
         // make sure to add the string IDs for nodes (Geode has no manual
         // hook order support yet so gotta do this to ensure)
         NodeIDs::provideFor(this);
@@ -1,4 +1,5 @@
 #include <Geode/loader/Loader.hpp>
+#include <SaveWriter.hpp>
 
 using namespace geode::prelude;
 
@@ -6,13 +7,20 @@ using namespace geode::prelude;
 #include <Geode/modify/CCApplication.hpp>
 
 namespace {
-    void saveModData() {
+    void saveModData(bool exiting) {
         log::info("Saving mod data...");
         log::pushNest();
 
         auto begin = std::chrono::high_resolution_clock::now();
 
         (void)Loader::get()->saveData();
+        // the files are written in the background, which only needs to be 
+        // waited on if the game is about to close
+        if (exiting) {
+            if (auto unwritten = SaveWriter::get()->flush(SaveWriter::EXIT_FLUSH_TIMEOUT)) {
+                log::warn("Timed out waiting for saves to finish, {} files were not written", unwritten);
+            }
+        }
 
         auto end = std::chrono::high_resolution_clock::now();
         auto time = std::chrono::duration_cast<std::chrono::milliseconds>(end - begin).count();
@@ -25,7 +33,8 @@ namespace {
 struct SaveLoader : Modify<SaveLoader, AppDelegate> {
     GEODE_FORWARD_COMPAT_DISABLE_HOOKS("save moved to CCApplication::gameDidSave()")
     void trySaveGame(bool p0) {
-        saveModData();
+        // p0 is true when the game is being closed
+        saveModData(p0);
         return AppDelegate::trySaveGame(p0);
     }
 };
@@ -35,7 +44,8 @@ struct SaveLoader : Modify<SaveLoader, AppDelegate> {
 struct FallbackSaveLoader : Modify<FallbackSaveLoader, CCApplication> {
     GEODE_FORWARD_COMPAT_ENABLE_HOOKS("")
     void gameDidSave() {
-        saveModData();
+        // no way to tell whether the game is closing here, so always wait
+        saveModData(true);
         return CCApplication::gameDidSave();
     }
 };
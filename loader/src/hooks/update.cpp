@@ -1,12 +1,157 @@
+#include <loader/FrameAttribution.hpp>
+#include <loader/HangWatchdog.hpp>
 #include <loader/LoaderImpl.hpp>
 
 using namespace geode::prelude;
 
+#include <Geode/modify/AppDelegate.hpp>
+#include <Geode/modify/CCActionInstant.hpp>
+#include <Geode/modify/CCActionInterval.hpp>
+#include <Geode/modify/CCActionManager.hpp>
+#include <Geode/modify/CCRepeatForever.hpp>
 #include <Geode/modify/CCScheduler.hpp>
+#include <Geode/modify/CCTimer.hpp>
 
 struct FunctionQueue : Modify<FunctionQueue, CCScheduler> {
     void update(float dt) {
+        HangWatchdog::get()->heartbeat();
+        FrameAttribution::get()->endFrame();
         LoaderImpl::get()->executeMainThreadQueue();
+        WeakRefPool::get()->sweep();
+        LoaderImpl::get()->updateHookProfiling();
         return CCScheduler::update(dt);
     }
 };
+
+// The hooks below tag scheduled selectors and actions with their mod, and 
+// time them when they run. They're only enabled while frame time 
+// attribution is, so they cost nothing otherwise
+template <class Self>
+static void addAttributionHooks(Self& self) {
+    for (auto& [_, hook] : self.m_hooks) {
+        hook->setAutoEnable(false);
+        if (!Loader::get()->isForwardCompatMode()) {
+            FrameAttribution::get()->addHook(hook.get());
+        }
+    }
+}
+
+// timed like a queued function, see Loader::Impl::executeMainThreadQueue
+template <class Run>
+static void runAttributed(Mod* owner, Run&& run) {
+    if (!owner) {
+        return run();
+    }
+    HookProfile profile;
+    profile.owner = owner;
+    HookProfileScope scope(&profile);
+    run();
+}
+
+struct SelectorAttribution : Modify<SelectorAttribution, CCScheduler> {
+    static void onModify(auto& self) {
+        addAttributionHooks(self);
+    }
+
+    void scheduleSelector(
+        SEL_SCHEDULE selector, CCObject* target, float interval, unsigned int repeat, float delay, bool paused
+    ) {
+        FrameAttribution::get()->tagSelector(target, selector);
+        CCScheduler::scheduleSelector(selector, target, interval, repeat, delay, paused);
+    }
+
+    // timers that finish their repeats unschedule themselves through this, 
+    // and unscheduleAll goes through unscheduleAllForTarget
+    void unscheduleSelector(SEL_SCHEDULE selector, CCObject* target) {
+        FrameAttribution::get()->untagSelector(target, selector);
+        CCScheduler::unscheduleSelector(selector, target);
+    }
+
+    void unscheduleAllForTarget(CCObject* target) {
+        FrameAttribution::get()->untagSelectors(target);
+        CCScheduler::unscheduleAllForTarget(target);
+    }
+};
+
+struct TimerAttribution : Modify<TimerAttribution, CCTimer> {
+    static void onModify(auto& self) {
+        addAttributionHooks(self);
+    }
+
+    void update(float dt) {
+        // the selector may unschedule itself, which frees the timer, so 
+        // nothing is read from it afterwards
+        runAttributed(
+            FrameAttribution::get()->getSelectorOwner(m_pTarget, m_pfnSelector),
+            [&] { CCTimer::update(dt); }
+        );
+    }
+};
+
+struct ActionAttribution : Modify<ActionAttribution, CCActionManager> {
+    static void onModify(auto& self) {
+        addAttributionHooks(self);
+    }
+
+    void addAction(CCAction* action, CCNode* target, bool paused) {
+        if (action) {
+            FrameAttribution::get()->tagAction(action);
+        }
+        CCActionManager::addAction(action, target, paused);
+    }
+};
+
+// the action manager steps every action through a virtual call, so these are 
+// the step implementations nearly all actions end up in. Actions nested in 
+// others aren't tagged, and are counted towards the outer action
+struct IntervalActionAttribution : Modify<IntervalActionAttribution, CCActionInterval> {
+    static void onModify(auto& self) {
+        addAttributionHooks(self);
+    }
+
+    void step(float dt) {
+        runAttributed(
+            FrameAttribution::get()->getActionOwner(this),
+            [&] { CCActionInterval::step(dt); }
+        );
+    }
+};
+
+struct InstantActionAttribution : Modify<InstantActionAttribution, CCActionInstant> {
+    static void onModify(auto& self) {
+        addAttributionHooks(self);
+    }
+
+    void step(float dt) {
+        runAttributed(
+            FrameAttribution::get()->getActionOwner(this),
+            [&] { CCActionInstant::step(dt); }
+        );
+    }
+};
+
+struct RepeatForeverAttribution : Modify<RepeatForeverAttribution, CCRepeatForever> {
+    static void onModify(auto& self) {
+        addAttributionHooks(self);
+    }
+
+    void step(float dt) {
+        runAttributed(
+            FrameAttribution::get()->getActionOwner(this),
+            [&] { CCRepeatForever::step(dt); }
+        );
+    }
+};
+
+// frames stop while the game is in the background, which isn't a hang
+struct HangWatchdogPause : Modify<HangWatchdogPause, AppDelegate> {
+    GEODE_FORWARD_COMPAT_DISABLE_HOOKS("hang watchdog won't pause in the background")
+    void applicationDidEnterBackground() {
+        HangWatchdog::get()->setPaused(true);
+        AppDelegate::applicationDidEnterBackground();
+    }
+    void applicationWillEnterForeground() {
+        AppDelegate::applicationWillEnterForeground();
+        HangWatchdog::get()->setPaused(false);
+    }
+};
@@ -11,44 +11,45 @@ using namespace geode::node_ids;
 
 $register_ids(MenuLayer) {
     // set IDs to everything
-    size_t spriteOffset = 0;
-    size_t labelOffset = 0;
+    auto children = ChildrenByType<CCSprite, CCLabelBMFont, CCMenu>(this);
+    int spriteOffset = 0;
+    int labelOffset = 0;
 
     setIDSafe(this, 0, "main-menu-bg");
-    setIDSafe<CCSprite>(this, spriteOffset++, "main-title");
+    setIDSafe<CCSprite>(children, spriteOffset++, "main-title");
 
     auto winSize = CCDirector::get()->getWinSize();
     auto GM = GameManager::sharedState();
 
     if(!GM->m_clickedGarage) {
-        setIDSafe<CCSprite>(this, spriteOffset++, "character-select-hint");
+        setIDSafe<CCSprite>(children, spriteOffset++, "character-select-hint");
     }
 
     if(!GM->m_clickedEditor) {
-        setIDSafe<CCSprite>(this, spriteOffset++, "level-editor-hint");
+        setIDSafe<CCSprite>(children, spriteOffset++, "level-editor-hint");
     }
 
     // controller
     if (PlatformToolbox::isControllerConnected()) {
-        setIDSafe<CCSprite>(this, spriteOffset++, "play-gamepad-icon");
-        setIDSafe<CCSprite>(this, spriteOffset++, "editor-gamepad-icon");
-        setIDSafe<CCSprite>(this, spriteOffset++, "icon-kit-gamepad-icon");
+        setIDSafe<CCSprite>(children, spriteOffset++, "play-gamepad-icon");
+        setIDSafe<CCSprite>(children, spriteOffset++, "editor-gamepad-icon");
+        setIDSafe<CCSprite>(children, spriteOffset++, "icon-kit-gamepad-icon");
 
-        setIDSafe<CCSprite>(this, spriteOffset++, "settings-gamepad-icon");
+        setIDSafe<CCSprite>(children, spriteOffset++, "settings-gamepad-icon");
 
         if(!GM->getGameVariable("0028")) {
-            setIDSafe<CCSprite>(this, spriteOffset++, "mouse-gamepad-icon");
-            setIDSafe<CCSprite>(this, spriteOffset++, "click-gamepad-icon");
+            setIDSafe<CCSprite>(children, spriteOffset++, "mouse-gamepad-icon");
+            setIDSafe<CCSprite>(children, spriteOffset++, "click-gamepad-icon");
 
-            setIDSafe<CCLabelBMFont>(this, labelOffset++, "mouse-gamepad-label");
-            setIDSafe<CCLabelBMFont>(this, labelOffset++, "click-gamepad-label");
+            setIDSafe<CCLabelBMFont>(children, labelOffset++, "mouse-gamepad-label");
+            setIDSafe<CCLabelBMFont>(children, labelOffset++, "click-gamepad-label");
         }
     }
     
-    setIDSafe<CCLabelBMFont>(this, labelOffset++, "player-username");
+    setIDSafe<CCLabelBMFont>(children, labelOffset++, "player-username");
     
     // main menu
-    if (auto menu = getChildOfType<CCMenu>(this, 0)) {
+    if (auto menu = children.get<CCMenu>(0)) {
         menu->setID("main-menu");
         auto playBtn = setIDSafe(menu, 0, "play-button");
         auto iconBtn = setIDSafe(menu, 1, "icon-kit-button");
@@ -83,7 +84,7 @@ $register_ids(MenuLayer) {
     }
 
     // bottom menu
-    if (auto menu = getChildOfType<CCMenu>(this, 1)) {
+    if (auto menu = children.get<CCMenu>(1)) {
         menu->setID("bottom-menu");
         auto ach = setIDSafe(menu, 0, "achievements-button");
         setIDSafe(menu, 1, "settings-button");
@@ -110,7 +111,7 @@ $register_ids(MenuLayer) {
     }
     
     // social media menu
-    if (auto menu = getChildOfType<CCMenu>(this, 2)) {
+    if (auto menu = children.get<CCMenu>(2)) {
         menu->setID("social-media-menu");
         setIDSafe(menu, 0, "robtop-logo-button");
         setIDSafe(menu, 1, "facebook-button");
@@ -121,7 +122,7 @@ $register_ids(MenuLayer) {
     }
     
     // more games menu
-    if (auto menu = getChildOfType<CCMenu>(this, 3)) {
+    if (auto menu = children.get<CCMenu>(3)) {
         menu->setID("more-games-menu");
         auto moreGamesBtn = setIDSafe(menu, 0, "more-games-button");
 
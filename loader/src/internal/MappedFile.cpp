@@ -0,0 +1,123 @@
+#include "MappedFile.hpp"
+
+#include <Geode/utils/file.hpp>
+#include <cerrno>
+#include <cstring>
+#include <utility>
+
+#ifdef GEODE_IS_WINDOWS
+#include <Windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+using namespace geode::prelude;
+
+MappedFile::MappedFile(MappedFile&& other) noexcept
+  : m_data(std::exchange(other.m_data, nullptr)),
+    m_size(std::exchange(other.m_size, 0)),
+    m_platformHandle(std::exchange(other.m_platformHandle, nullptr)) {}
+
+MappedFile& MappedFile::operator=(MappedFile&& other) noexcept {
+    // the old mapping is released when other goes out of scope
+    std::swap(m_data, other.m_data);
+    std::swap(m_size, other.m_size);
+    std::swap(m_platformHandle, other.m_platformHandle);
+    return *this;
+}
+
+#ifdef GEODE_IS_WINDOWS
+
+Result<MappedFile> MappedFile::create(ghc::filesystem::path const& path) {
+    // sharing delete access lets the file be replaced while it's mapped
+    auto file = CreateFileW(
+        path.wstring().c_str(), GENERIC_READ, FILE_SHARE_READ | FILE_SHARE_DELETE, nullptr,
+        OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, nullptr
+    );
+    if (file == INVALID_HANDLE_VALUE) {
+        return Err("Unable to open file: error {}", GetLastError());
+    }
+
+    LARGE_INTEGER size;
+    if (!GetFileSizeEx(file, &size)) {
+        auto err = GetLastError();
+        CloseHandle(file);
+        return Err("Unable to get file size: error {}", err);
+    }
+
+    MappedFile mapped;
+    mapped.m_size = static_cast<size_t>(size.QuadPart);
+    // empty files can't be mapped, but there's nothing to read anyway
+    if (mapped.m_size == 0) {
+        CloseHandle(file);
+        return Ok(std::move(mapped));
+    }
+
+    auto mapping = CreateFileMappingW(file, nullptr, PAGE_READONLY, 0, 0, nullptr);
+    // the mapping keeps the file open on its own
+    CloseHandle(file);
+    if (!mapping) {
+        return Err("Unable to map file: error {}", GetLastError());
+    }
+    auto view = MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0);
+    if (!view) {
+        auto err = GetLastError();
+        CloseHandle(mapping);
+        return Err("Unable to map file: error {}", err);
+    }
+    mapped.m_data = static_cast<uint8_t const*>(view);
+    mapped.m_platformHandle = mapping;
+    return Ok(std::move(mapped));
+}
+
+MappedFile::~MappedFile() {
+    if (m_data) {
+        UnmapViewOfFile(m_data);
+    }
+    if (m_platformHandle) {
+        CloseHandle(m_platformHandle);
+    }
+}
+
+#else
+
+Result<MappedFile> MappedFile::create(ghc::filesystem::path const& path) {
+    auto fd = open(path.c_str(), O_RDONLY);
+    if (fd < 0) {
+        return Err("Unable to open file: {}", std::strerror(errno));
+    }
+
+    struct stat info;
+    if (fstat(fd, &info) != 0) {
+        auto err = errno;
+        close(fd);
+        return Err("Unable to get file size: {}", std::strerror(err));
+    }
+
+    MappedFile mapped;
+    mapped.m_size = static_cast<size_t>(info.st_size);
+    if (mapped.m_size == 0) {
+        close(fd);
+        return Ok(std::move(mapped));
+    }
+
+    auto view = mmap(nullptr, mapped.m_size, PROT_READ, MAP_PRIVATE, fd, 0);
+    // the mapping keeps its own reference to the file
+    close(fd);
+    if (view == MAP_FAILED) {
+        return Err("Unable to map file: {}", std::strerror(errno));
+    }
+    mapped.m_data = static_cast<uint8_t const*>(view);
+    return Ok(std::move(mapped));
+}
+
+MappedFile::~MappedFile() {
+    if (m_data) {
+        munmap(const_cast<uint8_t*>(m_data), m_size);
+    }
+}
+
+#endif
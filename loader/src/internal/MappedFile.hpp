@@ -0,0 +1,35 @@
+#pragma once
+
+#include <Geode/DefaultInclude.hpp>
+#include <Geode/utils/Result.hpp>
+#include <ghc/fs_fwd.hpp>
+#include <cstdint>
+
+/**
+ * Read-only memory mapping of a whole file. The contents stay valid for as
+ * long as the MappedFile is alive
+ */
+class MappedFile final {
+protected:
+    uint8_t const* m_data = nullptr;
+    size_t m_size = 0;
+    void* m_platformHandle = nullptr;
+
+    MappedFile() = default;
+
+public:
+    static geode::Result<MappedFile> create(ghc::filesystem::path const& path);
+
+    MappedFile(MappedFile const&) = delete;
+    MappedFile& operator=(MappedFile const&) = delete;
+    MappedFile(MappedFile&& other) noexcept;
+    MappedFile& operator=(MappedFile&& other) noexcept;
+    ~MappedFile();
+
+    uint8_t const* data() const {
+        return m_data;
+    }
+    size_t size() const {
+        return m_size;
+    }
+};
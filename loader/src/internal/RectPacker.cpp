@@ -0,0 +1,106 @@
+#include "RectPacker.hpp"
+
+#include <algorithm>
+#include <limits>
+
+namespace {
+    bool contains(RectPacker::Rect const& outer, RectPacker::Rect const& inner) {
+        return inner.x >= outer.x && inner.y >= outer.y &&
+            inner.x + inner.width <= outer.x + outer.width &&
+            inner.y + inner.height <= outer.y + outer.height;
+    }
+
+    bool intersects(RectPacker::Rect const& a, RectPacker::Rect const& b) {
+        return a.x < b.x + b.width && b.x < a.x + a.width &&
+            a.y < b.y + b.height && b.y < a.y + a.height;
+    }
+}
+
+RectPacker::RectPacker(uint32_t width, uint32_t height)
+  : m_width(width), m_height(height), m_freeRects({ { 0, 0, width, height } }) {}
+
+std::optional<RectPacker::Rect> RectPacker::insert(uint32_t width, uint32_t height) {
+    if (width == 0 || height == 0) {
+        return std::nullopt;
+    }
+
+    std::optional<Rect> best;
+    auto bestShortSide = std::numeric_limits<uint32_t>::max();
+    auto bestLongSide = std::numeric_limits<uint32_t>::max();
+    for (auto const& free : m_freeRects) {
+        if (free.width < width || free.height < height) {
+            continue;
+        }
+        auto leftoverX = free.width - width;
+        auto leftoverY = free.height - height;
+        auto shortSide = std::min(leftoverX, leftoverY);
+        auto longSide = std::max(leftoverX, leftoverY);
+        if (shortSide < bestShortSide || (shortSide == bestShortSide && longSide < bestLongSide)) {
+            best = Rect { free.x, free.y, width, height };
+            bestShortSide = shortSide;
+            bestLongSide = longSide;
+        }
+    }
+    if (!best) {
+        return std::nullopt;
+    }
+
+    this->splitFreeRects(*best);
+    this->pruneFreeRects();
+    m_usedArea += static_cast<uint64_t>(width) * height;
+    return best;
+}
+
+void RectPacker::splitFreeRects(Rect const& used) {
+    std::vector<Rect> result;
+    result.reserve(m_freeRects.size() + 4);
+    for (auto const& free : m_freeRects) {
+        if (!intersects(free, used)) {
+            result.push_back(free);
+            continue;
+        }
+        // keep the maximal parts of the free rect on each side of the used one
+        if (used.x > free.x) {
+            result.push_back({ free.x, free.y, used.x - free.x, free.height });
+        }
+        if (used.x + used.width < free.x + free.width) {
+            auto x = used.x + used.width;
+            result.push_back({ x, free.y, free.x + free.width - x, free.height });
+        }
+        if (used.y > free.y) {
+            result.push_back({ free.x, free.y, free.width, used.y - free.y });
+        }
+        if (used.y + used.height < free.y + free.height) {
+            auto y = used.y + used.height;
+            result.push_back({ free.x, y, free.width, free.y + free.height - y });
+        }
+    }
+    m_freeRects = std::move(result);
+}
+
+void RectPacker::pruneFreeRects() {
+    // drop free rects that are fully inside another one
+    std::vector<Rect> result;
+    result.reserve(m_freeRects.size());
+    for (size_t i = 0; i < m_freeRects.size(); i++) {
+        bool redundant = false;
+        for (size_t j = 0; j < m_freeRects.size(); j++) {
+            if (i == j || !contains(m_freeRects[j], m_freeRects[i])) {
+                continue;
+            }
+            // of two identical rects, keep the first one
+            if (!contains(m_freeRects[i], m_freeRects[j]) || j < i) {
+                redundant = true;
+                break;
+            }
+        }
+        if (!redundant) {
+            result.push_back(m_freeRects[i]);
+        }
+    }
+    m_freeRects = std::move(result);
+}
+
+double RectPacker::getOccupancy() const {
+    return static_cast<double>(m_usedArea) / (static_cast<double>(m_width) * m_height);
+}
@@ -0,0 +1,49 @@
+#pragma once
+
+#include <cstdint>
+#include <optional>
+#include <vector>
+
+/**
+ * Packs rectangles into a fixed size bin using the MaxRects algorithm with
+ * the best short side fit heuristic. Rectangles are never rotated
+ */
+class RectPacker final {
+public:
+    struct Rect {
+        uint32_t x;
+        uint32_t y;
+        uint32_t width;
+        uint32_t height;
+    };
+
+protected:
+    uint32_t m_width;
+    uint32_t m_height;
+    uint64_t m_usedArea = 0;
+    // maximal free rectangles; these overlap each other
+    std::vector<Rect> m_freeRects;
+
+    void splitFreeRects(Rect const& used);
+    void pruneFreeRects();
+
+public:
+    RectPacker(uint32_t width, uint32_t height);
+
+    /**
+     * Find a spot for a rectangle and mark it as used
+     * @returns The placed rectangle, or nullopt if there's no room left
+     */
+    std::optional<Rect> insert(uint32_t width, uint32_t height);
+
+    uint32_t getWidth() const {
+        return m_width;
+    }
+    uint32_t getHeight() const {
+        return m_height;
+    }
+    /**
+     * Fraction of the bin's area that's been used, from 0 to 1
+     */
+    double getOccupancy() const;
+};
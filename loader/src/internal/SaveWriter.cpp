@@ -0,0 +1,83 @@
+#include "SaveWriter.hpp"
+
+#include <Geode/loader/Log.hpp>
+#include <Geode/utils/file.hpp>
+#include <Geode/utils/general.hpp>
+#include <cstdlib>
+#include <thread>
+
+using namespace geode::prelude;
+
+SaveWriter::SaveWriter() {
+    std::thread(&SaveWriter::run, this).detach();
+}
+
+SaveWriter* SaveWriter::get() {
+    // leaked on purpose, the writer thread may still be running during
+    // static destruction
+    static auto inst = [] {
+        auto writer = new SaveWriter();
+        // make sure whatever was queued last still makes it to disk even
+        // if the game exits without going through trySaveGame. This runs 
+        // during static teardown, so it mustn't log
+        std::atexit([] {
+            SaveWriter::get()->flush(EXIT_FLUSH_TIMEOUT);
+        });
+        return writer;
+    }();
+    return inst;
+}
+
+void SaveWriter::queue(ghc::filesystem::path const& path, std::string contents) {
+    {
+        std::lock_guard lock(m_mutex);
+        m_pending.insert_or_assign(path.string(), std::move(contents));
+    }
+    m_queued.notify_one();
+}
+
+size_t SaveWriter::flush(std::chrono::milliseconds timeout) {
+    std::unique_lock lock(m_mutex);
+    m_idle.wait_for(lock, timeout, [this] {
+        return m_pending.empty() && !m_writing;
+    });
+    return m_pending.size() + (m_writing ? 1 : 0);
+}
+
+void SaveWriter::run() {
+    thread::setName("Save Writer");
+
+    while (true) {
+        std::unordered_map<std::string, std::string> batch;
+        {
+            std::unique_lock lock(m_mutex);
+            m_queued.wait(lock, [this] { return !m_pending.empty(); });
+            batch.swap(m_pending);
+            m_writing = true;
+        }
+        for (auto& [path, contents] : batch) {
+            write(path, contents);
+        }
+        {
+            std::lock_guard lock(m_mutex);
+            m_writing = false;
+        }
+        m_idle.notify_all();
+    }
+}
+
+void SaveWriter::write(ghc::filesystem::path const& path, std::string const& contents) {
+    auto tmpPath = path;
+    tmpPath += ".tmp";
+    auto res = file::writeString(tmpPath, contents);
+    if (!res) {
+        log::error("Unable to save {}: {}", path, res.unwrapErr());
+        return;
+    }
+    std::error_code ec;
+    ghc::filesystem::rename(tmpPath, path, ec);
+    if (ec) {
+        log::error("Unable to save {}: {}", path, ec.message());
+        ghc::filesystem::remove(tmpPath, ec);
+    }
+}
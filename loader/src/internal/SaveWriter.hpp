@@ -0,0 +1,51 @@
+#pragma once
+
+#include <Geode/DefaultInclude.hpp>
+#include <ghc/filesystem.hpp>
+#include <chrono>
+#include <condition_variable>
+#include <mutex>
+#include <unordered_map>
+
+/**
+ * Writes mod save files on a background thread, so saving doesn't stall
+ * the game. Files are written to a temporary file that then replaces the 
+ * real one, so a crash mid-write never leaves a truncated save behind
+ */
+class SaveWriter final {
+protected:
+    std::mutex m_mutex;
+    // wakes up the writer thread when there's something to write
+    std::condition_variable m_queued;
+    // wakes up flush when the writer has nothing left to do
+    std::condition_variable m_idle;
+    // if a file is queued again before the writer gets to it, only the
+    // newest contents are written
+    std::unordered_map<std::string, std::string> m_pending;
+    bool m_writing = false;
+
+    SaveWriter();
+
+    void run();
+    static void write(ghc::filesystem::path const& path, std::string const& contents);
+
+public:
+    /**
+     * How long exiting the game may be held up by saves that haven't been
+     * written yet
+     */
+    static constexpr std::chrono::milliseconds EXIT_FLUSH_TIMEOUT{3000};
+
+    static SaveWriter* get();
+
+    /**
+     * Queue a file to be written
+     */
+    void queue(ghc::filesystem::path const& path, std::string contents);
+    /**
+     * Wait for every queued file to be written
+     * @param timeout How long to wait at most
+     * @returns The number of files that weren't written before the timeout
+     */
+    size_t flush(std::chrono::milliseconds timeout);
+};
@@ -0,0 +1,129 @@
+#include "Tracer.hpp"
+
+#include <Geode/loader/Dirs.hpp>
+#include <Geode/loader/Log.hpp>
+#include <Geode/utils/file.hpp>
+#include <Geode/utils/general.hpp>
+#include <chrono>
+
+using namespace geode::prelude;
+
+Tracer* Tracer::get() {
+    static auto inst = new Tracer();
+    return inst;
+}
+
+int64_t Tracer::now() {
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(
+        std::chrono::steady_clock::now().time_since_epoch()
+    ).count();
+}
+
+void Tracer::setEnabled(bool enabled) {
+    if (enabled && !this->isEnabled()) {
+        m_startNs = now();
+    }
+    m_enabled.store(enabled, std::memory_order_relaxed);
+}
+
+Tracer::ThreadBuffer& Tracer::getThreadBuffer() {
+    static thread_local ThreadBuffer* buffer = nullptr;
+    if (!buffer) {
+        auto created = std::make_shared<ThreadBuffer>();
+        created->threadName = thread::getName();
+        std::lock_guard lock(m_buffersMutex);
+        created->id = static_cast<uint32_t>(m_buffers.size() + 1);
+        m_buffers.push_back(created);
+        buffer = created.get();
+    }
+    return *buffer;
+}
+
+void Tracer::record(char const* name, std::string_view detail, int64_t startNs, int64_t endNs) {
+    auto& buffer = this->getThreadBuffer();
+    std::lock_guard lock(buffer.mutex);
+    buffer.events.push_back({ name, std::string(detail), startNs, endNs });
+}
+
+Result<ghc::filesystem::path> Tracer::write() {
+    if (m_startNs == 0) {
+        return Err("Startup tracing isn't enabled, launch with --geode:trace-startup");
+    }
+
+    auto toMicros = [this](int64_t ns) {
+        return static_cast<double>(ns - m_startNs) / 1000.0;
+    };
+
+    auto events = matjson::Array();
+    {
+        std::lock_guard lock(m_buffersMutex);
+        for (auto& buffer : m_buffers) {
+            std::lock_guard bufferLock(buffer->mutex);
+
+            auto threadName = matjson::Object();
+            threadName["name"] = buffer->threadName;
+            auto meta = matjson::Object();
+            meta["name"] = "thread_name";
+            meta["ph"] = "M";
+            meta["pid"] = 1;
+            meta["tid"] = static_cast<int>(buffer->id);
+            meta["args"] = threadName;
+            events.push_back(meta);
+
+            for (auto& event : buffer->events) {
+                auto obj = matjson::Object();
+                obj["name"] = event.name;
+                obj["cat"] = "geode";
+                obj["ph"] = "X";
+                obj["ts"] = toMicros(event.startNs);
+                obj["dur"] = static_cast<double>(event.endNs - event.startNs) / 1000.0;
+                obj["pid"] = 1;
+                obj["tid"] = static_cast<int>(buffer->id);
+                if (!event.detail.empty()) {
+                    auto args = matjson::Object();
+                    args["detail"] = event.detail;
+                    obj["args"] = args;
+                }
+                events.push_back(obj);
+            }
+        }
+    }
+
+    auto trace = matjson::Object();
+    trace["traceEvents"] = events;
+    trace["displayTimeUnit"] = "ms";
+
+    auto path = dirs::getGeodeLogDir() / "startup-trace.json";
+    GEODE_UNWRAP(file::writeString(path, matjson::Value(trace).dump(matjson::NO_INDENTATION)));
+    return Ok(path);
+}
+
+void Tracer::finishStartup() {
+    if (!this->isEnabled()) {
+        return;
+    }
+    this->record("Startup", {}, m_startNs, now());
+    // the trace only covers startup, so stop recording to not grow forever
+    m_enabled.store(false, std::memory_order_relaxed);
+
+    auto res = this->write();
+    if (!res) {
+        log::error("Failed to write startup trace: {}", res.unwrapErr());
+        return;
+    }
+    log::info("Wrote startup trace to {}", res.unwrap());
+}
+
+TraceSpan::TraceSpan(char const* name, std::string_view detail) : m_name(name) {
+    if (Tracer::get()->isEnabled()) {
+        m_detail = detail;
+        m_start = Tracer::now();
+    }
+}
+
+TraceSpan::~TraceSpan() {
+    // spans that started while tracing was disabled aren't recorded
+    if (m_start && Tracer::get()->isEnabled()) {
+        Tracer::get()->record(m_name, m_detail, m_start, Tracer::now());
+    }
+}
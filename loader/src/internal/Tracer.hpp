@@ -0,0 +1,87 @@
+#pragma once
+
+#include <Geode/DefaultInclude.hpp>
+#include <Geode/utils/Result.hpp>
+#include <ghc/filesystem.hpp>
+#include <atomic>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <string_view>
+#include <vector>
+
+/**
+ * Records timed spans of loader work into per-thread buffers and writes them
+ * out as a Chrome trace, which Perfetto and chrome://tracing can open. Used
+ * to break down where startup time goes. Enabled with the
+ * `--geode:trace-startup` launch argument; while disabled, a span costs a
+ * single atomic load
+ */
+class Tracer final {
+protected:
+    struct Event {
+        char const* name;
+        std::string detail;
+        int64_t startNs;
+        int64_t endNs;
+    };
+    struct ThreadBuffer {
+        uint32_t id;
+        std::string threadName;
+        // only ever contended while the trace is being written
+        std::mutex mutex;
+        std::vector<Event> events;
+    };
+
+    std::atomic<bool> m_enabled = false;
+    int64_t m_startNs = 0;
+    std::mutex m_buffersMutex;
+    // buffers outlive their threads, since most loader threads are detached
+    std::vector<std::shared_ptr<ThreadBuffer>> m_buffers;
+
+    ThreadBuffer& getThreadBuffer();
+
+public:
+    static Tracer* get();
+    static int64_t now();
+
+    void setEnabled(bool enabled);
+    bool isEnabled() const {
+        return m_enabled.load(std::memory_order_relaxed);
+    }
+
+    void record(char const* name, std::string_view detail, int64_t startNs, int64_t endNs);
+    /**
+     * Write everything recorded so far to startup-trace.json in the logs
+     * directory
+     * @returns The path of the written file
+     */
+    geode::Result<ghc::filesystem::path> write();
+    /**
+     * Record the whole startup as a span, write the trace and stop
+     * recording. Called once the main menu is first shown
+     */
+    void finishStartup();
+};
+
+/**
+ * Records the time between its construction and destruction as a span
+ */
+class TraceSpan final {
+protected:
+    char const* m_name;
+    std::string m_detail;
+    int64_t m_start = 0;
+
+public:
+    /**
+     * @param name The span's name. Must be a string literal
+     * @param detail Extra info shown with the span, like a mod's ID
+     */
+    explicit TraceSpan(char const* name, std::string_view detail = {});
+    ~TraceSpan();
+
+    TraceSpan(TraceSpan const&) = delete;
+    TraceSpan& operator=(TraceSpan const&) = delete;
+};
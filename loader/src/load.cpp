@@ -11,6 +11,8 @@
 #include <Geode/loader/ModJsonTest.hpp>
 #include <Geode/utils/JsonValidation.hpp>
 #include <loader/LogImpl.hpp>
+#include <internal/Tracer.hpp>
+#include <loader/SamplingProfiler.hpp>
 
 #include <array>
 
@@ -18,7 +20,30 @@ using namespace geode::prelude;
 
 #include "load.hpp"
 
+static void setSamplingProfilerEnabled(bool enabled) {
+    if (enabled) {
+        SamplingProfiler::get()->reset();
+        auto res = SamplingProfiler::get()->start(250);
+        if (!res) {
+            log::error("Unable to start sampling profiler: {}", res.unwrapErr());
+        }
+        return;
+    }
+    if (!SamplingProfiler::get()->isRunning()) {
+        return;
+    }
+    SamplingProfiler::get()->stop();
+    auto res = SamplingProfiler::get()->write();
+    if (!res) {
+        log::error("Unable to write sampling profile: {}", res.unwrapErr());
+        return;
+    }
+    log::info("Wrote sampling profile to {}", res.unwrap());
+}
+
 $execute {
+    listenForSettingChanges("sampling-profiler", &setSamplingProfilerEnabled);
+
     ipc::listen("ipc-test", [](ipc::IPCEvent* event) -> matjson::Value {
         return "Hello from Geode!";
     });
@@ -50,6 +75,14 @@ $execute {
 
         return res;
     });
+
+    ipc::listen("write-startup-trace", [](ipc::IPCEvent* event) -> matjson::Value {
+        auto res = Tracer::get()->write();
+        if (!res) {
+            return matjson::Object { { "error", res.unwrapErr() } };
+        }
+        return matjson::Object { { "path", res.unwrap().string() } };
+    });
 }
 
 void tryLogForwardCompat() {
@@ -166,6 +199,10 @@ int geodeEntry(void* platformData) {
 
     crashlog::setupPlatformHandlerPost();
 
+    if (Mod::get()->getSettingValue<bool>("sampling-profiler")) {
+        setSamplingProfilerEnabled(true);
+    }
+
     log::debug("Setting up IPC");
     log::pushNest();
     ipc::setup();
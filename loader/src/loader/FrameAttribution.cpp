@@ -0,0 +1,256 @@
+#include "FrameAttribution.hpp"
+
+#include "LoaderImpl.hpp"
+#include "ModImpl.hpp"
+
+#include <cstring>
+
+#ifdef GEODE_IS_WINDOWS
+#include <Windows.h>
+#else
+#include <cxxabi.h>
+#include <dlfcn.h>
+#endif
+
+FrameAttribution* FrameAttribution::get() {
+    static auto inst = new FrameAttribution();
+    return inst;
+}
+
+void FrameAttribution::setEnabled(bool enabled) {
+    if (this->isEnabled() == enabled) {
+        return;
+    }
+    // hook time is measured by the hook profiler
+    if (enabled) {
+        if (!Hook::isProfilingEnabled()) {
+            Hook::setProfilingEnabled(true);
+            m_enabledHookProfiling = true;
+        }
+        m_enabled.store(true, std::memory_order_relaxed);
+        if (auto res = Hook::enableBatch(m_hooks); !res) {
+            log::warn("Unable to enable frame time attribution hooks: {}", res.unwrapErr());
+        }
+    }
+    else {
+        // hook profiling refuses to turn off while we're still enabled
+        m_enabled.store(false, std::memory_order_relaxed);
+        if (auto res = Hook::disableBatch(m_hooks); !res) {
+            log::warn("Unable to disable frame time attribution hooks: {}", res.unwrapErr());
+        }
+        if (m_enabledHookProfiling) {
+            Hook::setProfilingEnabled(false);
+            m_enabledHookProfiling = false;
+        }
+        // whatever is scheduled from now on isn't tagged, so the old tags 
+        // would only go stale
+        m_selectorOwners.clear();
+        m_actionOwners.clear();
+    }
+    log::info("Frame time attribution {}", enabled ? "enabled" : "disabled");
+}
+
+void FrameAttribution::addHook(Hook* hook) {
+    m_hooks.push_back(hook);
+}
+
+// Finds the module containing an address, along with its path
+static std::pair<void const*, ghc::filesystem::path> moduleFromAddress(void const* address) {
+#ifdef GEODE_IS_WINDOWS
+    HMODULE module = nullptr;
+    if (!GetModuleHandleExW(
+        GET_MODULE_HANDLE_EX_FLAG_FROM_ADDRESS | GET_MODULE_HANDLE_EX_FLAG_UNCHANGED_REFCOUNT,
+        reinterpret_cast<LPCWSTR>(address), &module
+    )) {
+        return { nullptr, {} };
+    }
+    wchar_t buffer[MAX_PATH];
+    auto size = GetModuleFileNameW(module, buffer, MAX_PATH);
+    return { module, std::wstring(buffer, size) };
+#else
+    Dl_info info;
+    if (!dladdr(address, &info) || !info.dli_fname) {
+        return { nullptr, {} };
+    }
+    return { info.dli_fbase, info.dli_fname };
+#endif
+}
+
+Mod* FrameAttribution::modFromAddress(void const* address) {
+    auto [module, path] = moduleFromAddress(address);
+    if (!module) {
+        return nullptr;
+    }
+
+    std::lock_guard lock(m_modulesMutex);
+    if (auto it = m_modules.find(module); it != m_modules.end()) {
+        return it->second;
+    }
+
+    Mod* found = nullptr;
+    // the loader's own binary isn't listed as the internal mod's binary
+    if (module == moduleFromAddress(reinterpret_cast<void const*>(&FrameAttribution::get)).first) {
+        found = Mod::get();
+    }
+    else {
+        // binaries are named after their mod's ID, and some platforms load
+        // them from a copy, so only the names are compared
+        for (auto mod : Loader::get()->getAllMods()) {
+            if (mod->getBinaryPath().filename() == path.filename()) {
+                found = mod;
+                break;
+            }
+        }
+    }
+    // a mod is always known to the loader before any of its code runs, so
+    // a module that didn't match now never will
+    m_modules.insert({ module, found });
+    return found;
+}
+
+std::string FrameAttribution::describeAddress(void const* address) {
+    auto [module, path] = moduleFromAddress(address);
+    if (!module) {
+        return fmt::format("{}", address);
+    }
+    auto mod = this->modFromAddress(address);
+    auto name = mod ? mod->getID() : path.filename().string();
+
+#ifndef GEODE_IS_WINDOWS
+    Dl_info info;
+    if (dladdr(address, &info) && info.dli_sname) {
+        int status = 0;
+        auto demangled = abi::__cxa_demangle(info.dli_sname, nullptr, nullptr, &status);
+        std::string symbol = status == 0 && demangled ? demangled : info.dli_sname;
+        std::free(demangled);
+        return fmt::format("{}`{}", name, symbol);
+    }
+#endif
+
+    return fmt::format(
+        "{}+{:#x}", name,
+        reinterpret_cast<uintptr_t>(address) - reinterpret_cast<uintptr_t>(module)
+    );
+}
+
+// Finds the code a selector calls on a target
+static void const* selectorAddress(CCObject* target, SEL_SCHEDULE selector) {
+#ifdef GEODE_IS_WINDOWS
+    // CCObject only has single inheritance, so the member pointer is just a 
+    // code address; for virtual functions it points to a thunk, which is in 
+    // the binary that took the address
+    static_assert(sizeof(selector) == sizeof(void const*));
+    void const* address;
+    std::memcpy(&address, &selector, sizeof(address));
+    return address;
+#else
+    // Itanium member pointers are { ptr, adj }, where ptr is a vtable offset 
+    // for virtual functions. ARM keeps the virtual bit in adj instead of ptr
+    struct {
+        uintptr_t ptr;
+        ptrdiff_t adj;
+    } raw;
+    static_assert(sizeof(selector) == sizeof(raw));
+    std::memcpy(&raw, &selector, sizeof(raw));
+#if defined(__arm__) || defined(__aarch64__)
+    bool isVirtual = raw.adj & 1;
+    auto adj = raw.adj >> 1;
+    auto offset = raw.ptr;
+#else
+    bool isVirtual = raw.ptr & 1;
+    auto adj = raw.adj;
+    auto offset = raw.ptr - 1;
+#endif
+    if (!isVirtual) {
+        return reinterpret_cast<void const*>(raw.ptr);
+    }
+    auto vtable = *reinterpret_cast<char const* const*>(reinterpret_cast<char const*>(target) + adj);
+    return *reinterpret_cast<void const* const*>(vtable + offset);
+#endif
+}
+
+void FrameAttribution::tagSelector(CCObject* target, SEL_SCHEDULE selector) {
+    auto owner = this->modFromAddress(selectorAddress(target, selector));
+    if (!owner || owner == Mod::get()) {
+        owner = HookProfileScope::currentOwner();
+    }
+    // scheduling an already scheduled selector only changes its interval, 
+    // but it's tagged again all the same
+    this->untagSelector(target, selector);
+    if (owner) {
+        m_selectorOwners[target].push_back({ selector, owner });
+    }
+}
+
+void FrameAttribution::untagSelector(CCObject* target, SEL_SCHEDULE selector) {
+    auto it = m_selectorOwners.find(target);
+    if (it == m_selectorOwners.end()) {
+        return;
+    }
+    std::erase_if(it->second, [&](auto const& tag) { return tag.first == selector; });
+    if (it->second.empty()) {
+        m_selectorOwners.erase(it);
+    }
+}
+
+void FrameAttribution::untagSelectors(CCObject* target) {
+    m_selectorOwners.erase(target);
+}
+
+Mod* FrameAttribution::getSelectorOwner(CCObject* target, SEL_SCHEDULE selector) const {
+    auto it = m_selectorOwners.find(target);
+    if (it == m_selectorOwners.end()) {
+        return nullptr;
+    }
+    for (auto const& [tagged, owner] : it->second) {
+        if (tagged == selector) {
+            return owner;
+        }
+    }
+    return nullptr;
+}
+
+void FrameAttribution::tagAction(CCAction* action) {
+    // the vtable is in the binary that defines the class
+    auto owner = this->modFromAddress(*reinterpret_cast<void const* const*>(action));
+    if (!owner || owner == Mod::get()) {
+        owner = HookProfileScope::currentOwner();
+    }
+    if (owner) {
+        m_actionOwners.insert_or_assign(action, ActionTag { Ref<CCAction>(action), owner });
+    }
+    else {
+        m_actionOwners.erase(action);
+    }
+}
+
+Mod* FrameAttribution::getActionOwner(CCAction* action) const {
+    auto it = m_actionOwners.find(action);
+    return it != m_actionOwners.end() ? it->second.owner : nullptr;
+}
+
+void FrameAttribution::charge(Mod* mod, std::chrono::nanoseconds time) {
+    ModImpl::getImpl(mod)->m_frameTimeNs.fetch_add(time.count(), std::memory_order_relaxed);
+}
+
+void FrameAttribution::endFrame() {
+    if (!this->isEnabled()) {
+        return;
+    }
+    // the action manager lets go of actions once they're done, which 
+    // leaves our reference as the last one
+    for (auto it = m_actionOwners.begin(); it != m_actionOwners.end();) {
+        if (it->second.action->retainCount() == 1) {
+            it = m_actionOwners.erase(it);
+        }
+        else {
+            ++it;
+        }
+    }
+    for (auto mod : Loader::get()->getAllMods()) {
+        auto impl = ModImpl::getImpl(mod);
+        auto time = impl->m_frameTimeNs.exchange(0, std::memory_order_relaxed);
+        impl->m_frameHistory[impl->m_frameHistoryCount % impl->m_frameHistory.size()] = time;
+        impl->m_frameHistoryCount += 1;
+    }
+}
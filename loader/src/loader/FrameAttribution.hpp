@@ -0,0 +1,103 @@
+#pragma once
+
+#include <Geode/loader/Hook.hpp>
+#include <Geode/loader/Mod.hpp>
+#include <Geode/utils/cocos.hpp>
+#include <cocos2d.h>
+#include <atomic>
+#include <chrono>
+#include <mutex>
+#include <unordered_map>
+#include <vector>
+
+using namespace geode::prelude;
+
+/**
+ * Attributes main thread time to the mods whose code ran, so slow frames can
+ * be traced back to a mod. While enabled, functions queued through
+ * Loader::queueInMainThread are charged to the mod that queued them, hook
+ * detours to the mod that owns the hook (measured by the hook profiler), and
+ * scheduled selectors and actions to the mod they were tagged with when they
+ * were scheduled or added. Each mod keeps its totals for the last few frames
+ * in a ring buffer
+ */
+class FrameAttribution final {
+protected:
+    struct ActionTag {
+        // held so the action's address can't be reused by another one while 
+        // it's tagged, which nested actions (that never go through the 
+        // action manager) could otherwise pick up
+        Ref<CCAction> action;
+        Mod* owner;
+    };
+
+    std::atomic<bool> m_enabled = false;
+    // whether hook profiling was turned on by us, and so should be turned
+    // off again with us
+    bool m_enabledHookProfiling = false;
+    std::mutex m_modulesMutex;
+    std::unordered_map<void const*, Mod*> m_modules;
+    // cocos is only used from the main thread, so these aren't locked. The 
+    // scheduler retains targets until they're unscheduled, which is when 
+    // their selectors are untagged. Member function pointers can't be 
+    // hashed, but a target rarely has more than a few selectors
+    std::unordered_map<CCObject*, std::vector<std::pair<SEL_SCHEDULE, Mod*>>> m_selectorOwners;
+    // actions are untagged once we're the last one holding them, see endFrame
+    std::unordered_map<CCAction*, ActionTag> m_actionOwners;
+    // the hooks doing the tagging and timing, which are only enabled while 
+    // we are
+    std::vector<Hook*> m_hooks;
+
+public:
+    static FrameAttribution* get();
+
+    void setEnabled(bool enabled);
+    /**
+     * Add a hook that should only be enabled while attribution is. Called 
+     * when the hooks are created, so it should have auto enable turned off
+     */
+    void addHook(Hook* hook);
+    bool isEnabled() const {
+        return m_enabled.load(std::memory_order_relaxed);
+    }
+
+    /**
+     * Find the mod whose binary contains an address
+     * @returns The mod, or nullptr if the address isn't in any mod's binary
+     */
+    Mod* modFromAddress(void const* address);
+    /**
+     * Describe a code address for reports, as module`symbol where the
+     * symbol is known and module+offset otherwise. Code in a mod's binary
+     * uses the mod's ID as the module name
+     */
+    std::string describeAddress(void const* address);
+    /**
+     * Record which mod a selector that's being scheduled belongs to: the 
+     * mod whose binary the selector is in, or failing that, the mod whose 
+     * code is scheduling it
+     */
+    void tagSelector(CCObject* target, SEL_SCHEDULE selector);
+    void untagSelector(CCObject* target, SEL_SCHEDULE selector);
+    void untagSelectors(CCObject* target);
+    Mod* getSelectorOwner(CCObject* target, SEL_SCHEDULE selector) const;
+    /**
+     * Record which mod an action that's being run belongs to: the mod whose 
+     * binary defines the action's class, or failing that, the mod whose 
+     * code is running it
+     */
+    void tagAction(CCAction* action);
+    Mod* getActionOwner(CCAction* action) const;
+
+    /**
+     * Add time to a mod's total for the current frame. Safe to call from
+     * any thread
+     */
+    void charge(Mod* mod, std::chrono::nanoseconds time);
+    /**
+     * Move the current frame's totals into each mod's history, and drop the 
+     * tags of actions that have finished. Called at the start of every 
+     * frame
+     */
+    void endFrame();
+};
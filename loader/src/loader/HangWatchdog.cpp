@@ -0,0 +1,268 @@
+#include "HangWatchdog.hpp"
+
+#include "FrameAttribution.hpp"
+#include "SamplingProfiler.hpp"
+
+#include <Geode/utils/file.hpp>
+#include <Geode/utils/general.hpp>
+#include <algorithm>
+#include <cstdlib>
+#include <crashlog.hpp>
+#include <fmt/format.h>
+#include <fstream>
+#include <sstream>
+#include <thread>
+
+#ifdef GEODE_IS_WINDOWS
+#include <Windows.h>
+#elif defined(GEODE_IS_ANDROID)
+#include <csignal>
+#include <sys/syscall.h>
+#include <unistd.h>
+#endif
+
+HangWatchdog* HangWatchdog::get() {
+    static auto inst = new HangWatchdog();
+    return inst;
+}
+
+static int64_t steadyNow() {
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(
+        std::chrono::steady_clock::now().time_since_epoch()
+    ).count();
+}
+
+void HangWatchdog::setThreshold(std::chrono::milliseconds threshold) {
+    m_thresholdMs.store(threshold.count(), std::memory_order_relaxed);
+}
+
+void HangWatchdog::setPaused(bool paused) {
+    // the time spent paused isn't a frame
+    m_lastHeartbeatNs.store(0, std::memory_order_relaxed);
+    m_paused.store(paused, std::memory_order_relaxed);
+}
+
+void HangWatchdog::heartbeat() {
+    if (!m_started) {
+        this->start();
+    }
+
+    auto now = steadyNow();
+    auto last = m_lastHeartbeatNs.exchange(now, std::memory_order_relaxed);
+    auto count = m_heartbeats.fetch_add(1, std::memory_order_relaxed);
+    if (last == 0) {
+        return;
+    }
+
+    auto frameMs = (now - last) / 1'000'000;
+    for (size_t i = LONG_FRAME_BUCKETS_MS.size(); i-- > 0;) {
+        if (frameMs >= LONG_FRAME_BUCKETS_MS[i]) {
+            m_longFrames[i].fetch_add(1, std::memory_order_relaxed);
+            break;
+        }
+    }
+    if (m_reportedHeartbeat.load(std::memory_order_relaxed) == count) {
+        log::warn("Main thread recovered after {}s", static_cast<float>(frameMs) / 1000.f);
+    }
+}
+
+std::array<uint64_t, HangWatchdog::LONG_FRAME_BUCKETS_MS.size()> HangWatchdog::getLongFrameHistogram() const {
+    std::array<uint64_t, LONG_FRAME_BUCKETS_MS.size()> res;
+    for (size_t i = 0; i < res.size(); i++) {
+        res[i] = m_longFrames[i].load(std::memory_order_relaxed);
+    }
+    return res;
+}
+
+void HangWatchdog::start() {
+    m_started = true;
+#ifdef GEODE_IS_WINDOWS
+    HANDLE handle = nullptr;
+    DuplicateHandle(
+        GetCurrentProcess(), GetCurrentThread(), GetCurrentProcess(), &handle,
+        THREAD_SUSPEND_RESUME | THREAD_GET_CONTEXT | THREAD_QUERY_INFORMATION, false, 0
+    );
+    m_mainThreadHandle = handle;
+#elif defined(GEODE_IS_ANDROID)
+    m_mainThreadID = static_cast<int>(syscall(SYS_gettid));
+#endif
+    std::thread([this]() {
+        thread::setName("Hang Watchdog");
+        this->run();
+    }).detach();
+}
+
+void HangWatchdog::run() {
+    while (true) {
+        auto thresholdMs = m_thresholdMs.load(std::memory_order_relaxed);
+        std::this_thread::sleep_for(std::chrono::milliseconds(
+            std::clamp<int64_t>(thresholdMs / 4, 50, 1000)
+        ));
+        if (thresholdMs <= 0 || m_paused.load(std::memory_order_relaxed)) {
+            continue;
+        }
+        auto heartbeats = m_heartbeats.load(std::memory_order_relaxed);
+        auto last = m_lastHeartbeatNs.load(std::memory_order_relaxed);
+        if (last == 0 || m_reportedHeartbeat.load(std::memory_order_relaxed) == heartbeats) {
+            continue;
+        }
+        auto stalledFor = std::chrono::milliseconds((steadyNow() - last) / 1'000'000);
+        if (stalledFor.count() < thresholdMs || isDebuggerAttached()) {
+            continue;
+        }
+        m_reportedHeartbeat.store(heartbeats, std::memory_order_relaxed);
+        this->writeReport(stalledFor, this->captureMainThreadStack());
+    }
+}
+
+bool HangWatchdog::isDebuggerAttached() {
+#if defined(GEODE_IS_WINDOWS)
+    return IsDebuggerPresent();
+#elif defined(GEODE_IS_ANDROID)
+    // debuggers attach through ptrace, which shows up as a tracer here
+    std::ifstream status("/proc/self/status");
+    std::string line;
+    while (std::getline(status, line)) {
+        if (line.starts_with("TracerPid:")) {
+            return std::atoi(line.c_str() + 10) != 0;
+        }
+    }
+    return false;
+#else
+    return false;
+#endif
+}
+
+#ifdef GEODE_IS_ANDROID
+
+static std::array<uintptr_t, HangWatchdog::MAX_FRAMES> s_capturedFrames;
+static std::atomic<uint32_t> s_capturedDepth = 0;
+static std::atomic<bool> s_captured = false;
+
+static void handleCaptureSignal(int, siginfo_t*, void* context) {
+    auto savedErrno = errno;
+    s_capturedDepth.store(
+        SamplingProfiler::unwindContext(context, s_capturedFrames.data(), s_capturedFrames.size()),
+        std::memory_order_relaxed
+    );
+    s_captured.store(true, std::memory_order_release);
+    errno = savedErrno;
+}
+
+#endif
+
+std::vector<uintptr_t> HangWatchdog::captureMainThreadStack() {
+    std::vector<uintptr_t> stack;
+#if defined(GEODE_IS_WINDOWS)
+    auto thread = static_cast<HANDLE>(m_mainThreadHandle);
+    // nothing that could take a lock the main thread is holding (like
+    // allocating) can happen while it's suspended
+    std::array<uintptr_t, MAX_FRAMES> frames;
+    size_t depth = 0;
+    if (!thread || SuspendThread(thread) == static_cast<DWORD>(-1)) {
+        return stack;
+    }
+    CONTEXT context = {};
+    context.ContextFlags = CONTEXT_CONTROL | CONTEXT_INTEGER;
+    if (GetThreadContext(thread, &context)) {
+        uintptr_t sp = context.Esp;
+        uintptr_t fp = context.Ebp;
+        frames[depth++] = context.Eip;
+        while (depth < frames.size() && fp >= sp && fp - sp < 8 * 1024 * 1024) {
+            // the chain may be garbage, so read it without risking a fault
+            uintptr_t record[2];
+            SIZE_T read = 0;
+            if (
+                !ReadProcessMemory(GetCurrentProcess(), reinterpret_cast<void*>(fp), record, sizeof(record), &read) ||
+                read != sizeof(record) || record[1] == 0
+            ) {
+                break;
+            }
+            frames[depth++] = record[1] - 1;
+            if (record[0] <= fp) {
+                break;
+            }
+            fp = record[0];
+        }
+    }
+    ResumeThread(thread);
+    stack.assign(frames.begin(), frames.begin() + depth);
+#elif defined(GEODE_IS_ANDROID)
+    static bool handlerInstalled = false;
+    if (!handlerInstalled) {
+        struct sigaction action = {};
+        action.sa_sigaction = &handleCaptureSignal;
+        action.sa_flags = SA_SIGINFO | SA_RESTART;
+        sigemptyset(&action.sa_mask);
+        // SIGURG is ignored by default, so a stray one can't kill the game
+        if (sigaction(SIGURG, &action, nullptr) != 0) {
+            return stack;
+        }
+        handlerInstalled = true;
+    }
+    s_captured.store(false, std::memory_order_relaxed);
+    if (syscall(SYS_tgkill, getpid(), m_mainThreadID, SIGURG) != 0) {
+        return stack;
+    }
+    for (int i = 0; i < 1000 && !s_captured.load(std::memory_order_acquire); i++) {
+        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    }
+    if (s_captured.load(std::memory_order_acquire)) {
+        auto depth = s_capturedDepth.load(std::memory_order_relaxed);
+        stack.assign(s_capturedFrames.begin(), s_capturedFrames.begin() + depth);
+    }
+#endif
+    return stack;
+}
+
+void HangWatchdog::writeReport(std::chrono::milliseconds stalledFor, std::vector<uintptr_t> const& stack) {
+    Mod* blamed = nullptr;
+    std::stringstream trace;
+    for (auto address : stack) {
+        auto ptr = reinterpret_cast<void const*>(address);
+        if (!blamed) {
+            blamed = FrameAttribution::get()->modFromAddress(ptr);
+        }
+        trace << " - " << FrameAttribution::get()->describeAddress(ptr) << "\n";
+    }
+    if (stack.empty()) {
+        trace << "<Unable to capture the main thread's stack>\n";
+    }
+
+    std::stringstream file;
+    file << crashlog::getDateString(false) << "\n"
+         << "The main thread hasn't finished a frame in " << stalledFor.count() << "ms.\n";
+    if (blamed) {
+        file << "It appears to be stuck in code from the \"" << blamed->getID() << "\" mod.\n";
+    }
+
+    file << "\n== Geode Information ==\n";
+    crashlog::printGeodeInfo(file);
+
+    file << "\n== Main Thread Stack ==\n";
+    file << trace.str();
+
+    file << "\n== Long Frames ==\n";
+    auto histogram = this->getLongFrameHistogram();
+    for (size_t i = 0; i < histogram.size(); i++) {
+        file << ">= " << LONG_FRAME_BUCKETS_MS[i] << "ms: " << histogram[i] << "\n";
+    }
+
+    file << "\n== Installed Mods ==\n";
+    crashlog::printMods(file);
+
+    auto path = crashlog::getCrashLogDirectory() / ("hang-" + crashlog::getDateString(true) + ".log");
+    (void)file::createDirectoryAll(crashlog::getCrashLogDirectory());
+    auto res = file::writeString(path, file.str());
+
+    log::error(
+        "Main thread has been hung for {}s{}", static_cast<float>(stalledFor.count()) / 1000.f,
+        blamed ? fmt::format(", apparently in {}", blamed->getID()) : ""
+    );
+    if (res) {
+        log::error("Hang report written to {}", path);
+    }
+    else {
+        log::error("Unable to write hang report: {}", res.unwrapErr());
+    }
+}
@@ -0,0 +1,77 @@
+#pragma once
+
+#include <Geode/loader/Mod.hpp>
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <vector>
+
+using namespace geode::prelude;
+
+/**
+ * Notices when the main thread stops finishing frames. The main thread
+ * bumps a heartbeat every frame, and a background thread checks that it
+ * keeps doing so. If it doesn't for longer than the threshold, the main
+ * thread's stack is captured, blamed on the innermost mod in it, and
+ * written as a hang report next to the crashlogs. Every frame that's longer
+ * than usual is also counted in a histogram, so repeated stutters show up
+ * even if they never get long enough to be reported.
+ *
+ * Reporting is off unless enabled with the `--geode:enable-hang-reports` 
+ * or `--geode:hang-threshold=<ms>` launch arguments, and is skipped while 
+ * a debugger is attached, since sitting on a breakpoint looks just like a 
+ * hang
+ */
+class HangWatchdog final {
+public:
+    static constexpr size_t MAX_FRAMES = 64;
+    // lower bounds of the long frame histogram's buckets
+    static constexpr std::array<int64_t, 6> LONG_FRAME_BUCKETS_MS = { 50, 100, 250, 500, 1000, 5000 };
+    // used when reporting is enabled without a specific threshold
+    static constexpr auto DEFAULT_THRESHOLD = std::chrono::milliseconds(5000);
+
+protected:
+    std::atomic<int64_t> m_thresholdMs = 0;
+    std::atomic<bool> m_paused = false;
+    std::atomic<uint64_t> m_heartbeats = 0;
+    std::atomic<int64_t> m_lastHeartbeatNs = 0;
+    // the heartbeat count at the last reported hang, so each one is only
+    // reported once
+    std::atomic<uint64_t> m_reportedHeartbeat = UINT64_MAX;
+    std::array<std::atomic<uint64_t>, LONG_FRAME_BUCKETS_MS.size()> m_longFrames {};
+    bool m_started = false;
+    // the main thread's handle on Windows, its thread ID elsewhere
+    void* m_mainThreadHandle = nullptr;
+    int m_mainThreadID = 0;
+
+    void start();
+    void run();
+    static bool isDebuggerAttached();
+    std::vector<uintptr_t> captureMainThreadStack();
+    void writeReport(std::chrono::milliseconds stalledFor, std::vector<uintptr_t> const& stack);
+
+public:
+    static HangWatchdog* get();
+
+    /**
+     * Set how long the main thread can go without finishing a frame before
+     * it's considered hung. Zero disables reporting
+     */
+    void setThreshold(std::chrono::milliseconds threshold);
+    /**
+     * Stop reporting hangs, for when the game isn't drawing frames on
+     * purpose, like while it's in the background
+     */
+    void setPaused(bool paused);
+    /**
+     * Mark a frame as finished. Called every frame from the main thread;
+     * the first call starts the watchdog
+     */
+    void heartbeat();
+    /**
+     * Get how many frames took longer than each of LONG_FRAME_BUCKETS_MS,
+     * but not longer than the next one
+     */
+    std::array<uint64_t, LONG_FRAME_BUCKETS_MS.size()> getLongFrameHistogram() const;
+};
@@ -32,6 +32,30 @@ Result<> Hook::disable() {
     return m_impl->disable();
 }
 
+Result<> Hook::enableBatch(std::vector<Hook*> const& hooks) {
+    std::vector<Impl*> impls;
+    impls.reserve(hooks.size());
+    for (auto hook : hooks) {
+        impls.push_back(hook->m_impl.get());
+    }
+    if (auto failed = Impl::enableBatch(std::move(impls))) {
+        return Err("{} of {} hooks failed to enable", failed, hooks.size());
+    }
+    return Ok();
+}
+
+Result<> Hook::disableBatch(std::vector<Hook*> const& hooks) {
+    std::vector<Impl*> impls;
+    impls.reserve(hooks.size());
+    for (auto hook : hooks) {
+        impls.push_back(hook->m_impl.get());
+    }
+    if (auto failed = Impl::disableBatch(std::move(impls))) {
+        return Err("{} of {} hooks failed to disable", failed, hooks.size());
+    }
+    return Ok();
+}
+
 bool Hook::getAutoEnable() const {
     return m_impl->getAutoEnable();
 }
@@ -67,3 +91,27 @@ int32_t Hook::getPriority() const {
 void Hook::setPriority(int32_t priority) {
     return m_impl->setPriority(priority);
 }
+
+void Hook::setProfiledDetour(void* detour, HookProfile** profileSlot) {
+    return m_impl->setProfiledDetour(detour, profileSlot);
+}
+
+std::optional<HookProfileInfo> Hook::getProfileInfo() const {
+    return m_impl->getProfileInfo();
+}
+
+void Hook::setProfilingEnabled(bool enabled) {
+    return Impl::setProfilingEnabled(enabled);
+}
+
+bool Hook::isProfilingEnabled() {
+    return Impl::isProfilingEnabled();
+}
+
+std::chrono::nanoseconds Hook::getProfilingOverhead() {
+    return Impl::getProfilingOverhead();
+}
+
+void Hook::resetProfiles() {
+    return Impl::resetProfiles();
+}
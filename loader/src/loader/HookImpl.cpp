@@ -1,8 +1,80 @@
 #include "HookImpl.hpp"
 
+#include <algorithm>
+#include <mutex>
+#include <span>
+#include <unordered_set>
 #include <utility>
+#include "FrameAttribution.hpp"
 #include "LoaderImpl.hpp"
 
+// how often a summary of the most expensive hooks is logged while profiling
+static constexpr auto PROFILE_SUMMARY_INTERVAL = std::chrono::seconds(30);
+// how many hooks are listed in each summary
+static constexpr size_t PROFILE_SUMMARY_SIZE = 10;
+
+struct Hook::Impl::ProfilerState {
+    std::atomic<bool> enabled = false;
+    std::atomic<int64_t> overheadNs = 0;
+    std::chrono::steady_clock::time_point lastSummary;
+    // every hook with an instrumented detour, profiled or not
+    std::mutex mutex;
+    std::unordered_set<Hook::Impl*> hooks;
+};
+
+Hook::Impl::ProfilerState& Hook::Impl::getProfilerState() {
+    static auto inst = new ProfilerState();
+    return *inst;
+}
+
+static int64_t profileClock() {
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(
+        std::chrono::steady_clock::now().time_since_epoch()
+    ).count();
+}
+
+// the innermost profiled hook currently running on this thread, so nested
+// hooks can be subtracted from their caller's exclusive time
+static thread_local HookProfileScope* s_currentProfileScope = nullptr;
+
+HookProfileScope::HookProfileScope(HookProfile* profile) :
+    m_profile(profile),
+    m_parent(s_currentProfileScope),
+    m_start(profileClock()) {
+    s_currentProfileScope = this;
+}
+
+Mod* HookProfileScope::currentOwner() {
+    // the loader's own hooks (like the ones doing the attribution) wrap 
+    // plenty of code that isn't its own
+    for (auto scope = s_currentProfileScope; scope; scope = scope->m_parent) {
+        if (scope->m_profile && scope->m_profile->owner && scope->m_profile->owner != Mod::get()) {
+            return scope->m_profile->owner;
+        }
+    }
+    return nullptr;
+}
+
+HookProfileScope::~HookProfileScope() {
+    auto inclusive = profileClock() - m_start;
+    s_currentProfileScope = m_parent;
+    if (m_parent) {
+        m_parent->m_childNs += inclusive;
+    }
+    // this can only be null if the slot wasn't filled in before the
+    // profiled detour got enabled, which the hook makes sure of
+    if (m_profile) {
+        m_profile->calls.fetch_add(1, std::memory_order_relaxed);
+        m_profile->inclusiveNs.fetch_add(inclusive, std::memory_order_relaxed);
+        m_profile->exclusiveNs.fetch_add(inclusive - m_childNs, std::memory_order_relaxed);
+        if (m_profile->owner && FrameAttribution::get()->isEnabled()) {
+            FrameAttribution::get()->charge(
+                m_profile->owner, std::chrono::nanoseconds(inclusive - m_childNs)
+            );
+        }
+    }
+}
+
 Hook::Impl::Impl(
     void* address,
     void* detour,
@@ -21,6 +93,14 @@ Hook::Impl::~Impl() {
             log::error("Failed to disable hook: {}", res.unwrapErr());
         }
     }
+    if (m_profiledDetour) {
+        auto& state = getProfilerState();
+        std::lock_guard lock(state.mutex);
+        state.hooks.erase(this);
+        if (*m_profileSlot == &m_profile) {
+            *m_profileSlot = nullptr;
+        }
+    }
     if (m_owner) {
         auto res = m_owner->disownHook(m_self);
         if (!res) {
@@ -44,30 +124,47 @@ std::shared_ptr<Hook> Hook::Impl::create(
     });
 }
 
-Result<> Hook::Impl::enable() {
-    if (m_enabled) {
-        return Ok();
-    }
-
+bool Hook::Impl::isPlaceholder() const {
     // During a transition between updates when it's important to get a
     // non-functional version that compiles, address 0x9999999 is used to mark
     // functions not yet RE'd but that would prevent compilation
-    if ((uintptr_t)m_address == (geode::base::get() + 0x9999999)) {
-        if (m_owner) {
-            log::warn(
-                "Hook {} for {} uses placeholder address, refusing to hook",
-                m_displayName, m_owner->getID()
-            );
-        }
-        else {
-            log::warn("Hook {} uses placeholder address, refusing to hook", m_displayName);
-        }
+    if ((uintptr_t)m_address != (geode::base::get() + 0x9999999)) {
+        return false;
+    }
+    if (m_owner) {
+        log::warn(
+            "Hook {} for {} uses placeholder address, refusing to hook",
+            m_displayName, m_owner->getID()
+        );
+    }
+    else {
+        log::warn("Hook {} uses placeholder address, refusing to hook", m_displayName);
+    }
+    return true;
+}
+
+void Hook::Impl::enableInHandler(tulip::hook::HandlerHandle handler) {
+    static size_t enableCount = 0;
+    m_handle = tulip::hook::createHook(
+        handler, m_profiling ? m_profiledDetour : m_detour, m_hookMetadata
+    );
+    m_enabled = true;
+    m_enableOrder = enableCount++;
+    m_profile.owner = m_owner;
+}
+
+void Hook::Impl::disableInHandler(tulip::hook::HandlerHandle handler) {
+    tulip::hook::removeHook(handler, m_handle);
+    m_enabled = false;
+}
+
+Result<> Hook::Impl::enable() {
+    if (m_enabled || this->isPlaceholder()) {
         return Ok();
     }
 
     GEODE_UNWRAP_INTO(auto handler, LoaderImpl::get()->getOrCreateHandler(m_address, m_handlerMetadata));
-    m_handle = tulip::hook::createHook(handler, m_detour, m_hookMetadata);
-    m_enabled = true;
+    this->enableInHandler(handler);
 
     if (m_owner) {
         log::debug("Enabled {} hook at {} for {}", m_displayName, m_address, m_owner->getID());
@@ -83,12 +180,95 @@ Result<> Hook::Impl::disable() {
     if (!m_enabled)
         return Ok();
     GEODE_UNWRAP_INTO(auto handler, LoaderImpl::get()->getHandler(m_address));
-    tulip::hook::removeHook(handler, m_handle);
-    m_enabled = false;
+    this->disableInHandler(handler);
     log::debug("Disabled {} hook", m_displayName);
     return Ok();
 }
 
+// Sorts the hooks so that hooks on the same function are next to each other,
+// and calls the callback once for each of those groups. The sort is stable so
+// hooks with the same priority keep the order they were claimed in
+template <class Hooks, class Callback>
+static size_t forEachHandlerGroup(Hooks& hooks, Callback&& callback) {
+    std::stable_sort(hooks.begin(), hooks.end(), [](auto a, auto b) {
+        return a->getAddress() < b->getAddress();
+    });
+    size_t groups = 0;
+    for (auto it = hooks.begin(); it != hooks.end(); groups++) {
+        auto end = std::find_if(it, hooks.end(), [&](auto hook) {
+            return hook->getAddress() != (*it)->getAddress();
+        });
+        callback(*it, std::span(it, end));
+        it = end;
+    }
+    return groups;
+}
+
+size_t Hook::Impl::enableBatch(std::vector<Hook::Impl*> hooks) {
+    auto start = std::chrono::steady_clock::now();
+    std::erase_if(hooks, [](auto hook) {
+        return hook->m_enabled || hook->isPlaceholder();
+    });
+    if (hooks.empty()) {
+        return 0;
+    }
+
+    size_t failed = 0;
+    auto functions = forEachHandlerGroup(hooks, [&](auto first, auto group) {
+        auto handler = LoaderImpl::get()->getOrCreateHandler(first->m_address, first->m_handlerMetadata);
+        for (auto hook : group) {
+            if (handler) {
+                hook->enableInHandler(handler.unwrap());
+            }
+            else {
+                failed += 1;
+                log::logImpl(
+                    Severity::Error, hook->m_owner, "Failed to enable {} hook: {}",
+                    hook->m_displayName, handler.unwrapErr()
+                );
+            }
+        }
+    });
+
+    auto time = std::chrono::duration_cast<std::chrono::microseconds>(
+        std::chrono::steady_clock::now() - start
+    );
+    log::debug(
+        "Enabled {} hooks on {} functions in {}us",
+        hooks.size() - failed, functions, time.count()
+    );
+    return failed;
+}
+
+size_t Hook::Impl::disableBatch(std::vector<Hook::Impl*> hooks) {
+    std::erase_if(hooks, [](auto hook) {
+        return !hook->m_enabled;
+    });
+    if (hooks.empty()) {
+        return 0;
+    }
+
+    size_t failed = 0;
+    auto functions = forEachHandlerGroup(hooks, [&](auto first, auto group) {
+        auto handler = LoaderImpl::get()->getHandler(first->m_address);
+        for (auto hook : group) {
+            if (handler) {
+                hook->disableInHandler(handler.unwrap());
+            }
+            else {
+                failed += 1;
+                log::logImpl(
+                    Severity::Error, hook->m_owner, "Failed to disable {} hook: {}",
+                    hook->m_displayName, handler.unwrapErr()
+                );
+            }
+        }
+    });
+
+    log::debug("Disabled {} hooks on {} functions", hooks.size() - failed, functions);
+    return failed;
+}
+
 uintptr_t Hook::Impl::getAddress() const {
     return reinterpret_cast<uintptr_t>(m_address);
 }
@@ -103,6 +283,13 @@ matjson::Value Hook::Impl::getRuntimeInfo() const {
     json["detour"] = std::to_string(reinterpret_cast<uintptr_t>(m_detour));
     json["name"] = m_displayName;
     json["enabled"] = m_enabled;
+    if (auto info = this->getProfileInfo(); info && info->calls) {
+        auto profile = matjson::Object();
+        profile["calls"] = static_cast<double>(info->calls);
+        profile["inclusive-ns"] = static_cast<double>(info->inclusiveTime.count());
+        profile["exclusive-ns"] = static_cast<double>(info->exclusiveTime.count());
+        json["profile"] = profile;
+    }
     return json;
 }
 
@@ -136,3 +323,191 @@ Result<> Hook::Impl::updateHookMetadata() {
     tulip::hook::updateHookMetadata(handler, m_handle, m_hookMetadata);
     return Ok();
 }
+
+void Hook::Impl::setProfiledDetour(void* detour, HookProfile** profileSlot) {
+    if (m_profiledDetour) {
+        return;
+    }
+    m_profiledDetour = detour;
+    m_profileSlot = profileSlot;
+
+    auto& state = getProfilerState();
+    {
+        std::lock_guard lock(state.mutex);
+        state.hooks.insert(this);
+    }
+    if (state.enabled.load(std::memory_order_relaxed)) {
+        auto res = this->setProfiling(true);
+        if (!res) {
+            log::error("Failed to enable profiling for {}: {}", m_displayName, res.unwrapErr());
+        }
+    }
+}
+
+std::optional<HookProfileInfo> Hook::Impl::getProfileInfo() const {
+    if (!m_profiledDetour) {
+        return std::nullopt;
+    }
+    return HookProfileInfo {
+        .calls = m_profile.calls.load(std::memory_order_relaxed),
+        .inclusiveTime = std::chrono::nanoseconds(m_profile.inclusiveNs.load(std::memory_order_relaxed)),
+        .exclusiveTime = std::chrono::nanoseconds(m_profile.exclusiveNs.load(std::memory_order_relaxed)),
+    };
+}
+
+Result<> Hook::Impl::setProfiling(bool profiling) {
+    if (!m_profiledDetour || m_profiling == profiling) {
+        return Ok();
+    }
+    if (profiling) {
+        *m_profileSlot = &m_profile;
+    }
+    if (!m_enabled) {
+        m_profiling = profiling;
+        return Ok();
+    }
+    // swap the detour by recreating the hook in the same handler
+    GEODE_UNWRAP(this->disable());
+    m_profiling = profiling;
+    return this->enable();
+}
+
+static int64_t measureProfilingOverhead() {
+    constexpr int64_t ITERATIONS = 4096;
+    HookProfile profile;
+    auto start = profileClock();
+    for (int64_t i = 0; i < ITERATIONS; i++) {
+        HookProfileScope scope(&profile);
+    }
+    return (profileClock() - start) / ITERATIONS;
+}
+
+void Hook::Impl::setProfilingEnabled(bool enabled) {
+    auto& state = getProfilerState();
+    if (state.enabled.load(std::memory_order_relaxed) == enabled) {
+        return;
+    }
+    if (!enabled && FrameAttribution::get()->isEnabled()) {
+        log::warn("Hook profiling can't be disabled while frame time attribution is enabled");
+        return;
+    }
+    if (enabled) {
+        state.overheadNs.store(measureProfilingOverhead(), std::memory_order_relaxed);
+        state.lastSummary = std::chrono::steady_clock::now();
+    }
+    state.enabled.store(enabled, std::memory_order_relaxed);
+
+    std::lock_guard lock(state.mutex);
+    // swap the detours of every enabled hook in one batch, re-enabling them
+    // in their original order so hooks with equal priority stay in order
+    std::vector<Hook::Impl*> active;
+    for (auto hook : state.hooks) {
+        if (enabled) {
+            *hook->m_profileSlot = &hook->m_profile;
+        }
+        if (hook->m_enabled) {
+            active.push_back(hook);
+        }
+    }
+    std::sort(active.begin(), active.end(), [](auto a, auto b) {
+        return a->m_enableOrder < b->m_enableOrder;
+    });
+    Hook::Impl::disableBatch(active);
+    for (auto hook : state.hooks) {
+        hook->m_profiling = enabled;
+    }
+    Hook::Impl::enableBatch(std::move(active));
+    if (enabled) {
+        log::info(
+            "Hook profiling enabled for {} hooks, ~{}ns of overhead per call",
+            state.hooks.size(), state.overheadNs.load(std::memory_order_relaxed)
+        );
+    }
+    else {
+        log::info("Hook profiling disabled");
+    }
+}
+
+bool Hook::Impl::isProfilingEnabled() {
+    return getProfilerState().enabled.load(std::memory_order_relaxed);
+}
+
+std::chrono::nanoseconds Hook::Impl::getProfilingOverhead() {
+    return std::chrono::nanoseconds(
+        getProfilerState().overheadNs.load(std::memory_order_relaxed)
+    );
+}
+
+void Hook::Impl::resetProfiles() {
+    auto& state = getProfilerState();
+    std::lock_guard lock(state.mutex);
+    for (auto hook : state.hooks) {
+        hook->m_profile.calls.store(0, std::memory_order_relaxed);
+        hook->m_profile.inclusiveNs.store(0, std::memory_order_relaxed);
+        hook->m_profile.exclusiveNs.store(0, std::memory_order_relaxed);
+        hook->m_lastSummary = HookProfileInfo();
+    }
+}
+
+void Hook::Impl::updateProfiling() {
+    auto& state = getProfilerState();
+    if (!state.enabled.load(std::memory_order_relaxed)) {
+        return;
+    }
+    auto now = std::chrono::steady_clock::now();
+    if (now - state.lastSummary < PROFILE_SUMMARY_INTERVAL) {
+        return;
+    }
+    auto elapsed = std::chrono::duration_cast<std::chrono::seconds>(now - state.lastSummary);
+    state.lastSummary = now;
+
+    struct Entry {
+        Hook::Impl* hook;
+        HookProfileInfo delta;
+    };
+    std::vector<Entry> entries;
+    {
+        std::lock_guard lock(state.mutex);
+        for (auto hook : state.hooks) {
+            auto info = *hook->getProfileInfo();
+            auto delta = HookProfileInfo {
+                .calls = info.calls - hook->m_lastSummary.calls,
+                .inclusiveTime = info.inclusiveTime - hook->m_lastSummary.inclusiveTime,
+                .exclusiveTime = info.exclusiveTime - hook->m_lastSummary.exclusiveTime,
+            };
+            hook->m_lastSummary = info;
+            if (delta.calls) {
+                entries.push_back({ hook, delta });
+            }
+        }
+    }
+    if (entries.empty()) {
+        return;
+    }
+    auto count = std::min(entries.size(), PROFILE_SUMMARY_SIZE);
+    std::partial_sort(
+        entries.begin(), entries.begin() + count, entries.end(),
+        [](Entry const& a, Entry const& b) {
+            return a.delta.exclusiveTime > b.delta.exclusiveTime;
+        }
+    );
+
+    using Millis = std::chrono::duration<double, std::milli>;
+    log::info(
+        "Most expensive hooks over the last {}s (~{}ns of profiling overhead per call):",
+        elapsed.count(), state.overheadNs.load(std::memory_order_relaxed)
+    );
+    log::pushNest();
+    for (size_t i = 0; i < count; i++) {
+        auto& entry = entries[i];
+        log::info(
+            "{} ({}): {} calls, {:.2f}ms inclusive, {:.2f}ms exclusive",
+            entry.hook->m_displayName,
+            entry.hook->m_owner ? entry.hook->m_owner->getID() : "no owner",
+            entry.delta.calls,
+            Millis(entry.delta.inclusiveTime).count(),
+            Millis(entry.delta.exclusiveTime).count()
+        );
+    }
+    log::popNest();
+}
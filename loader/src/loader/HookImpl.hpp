@@ -5,6 +5,8 @@
 #include <Geode/loader/Mod.hpp>
 #include <Geode/utils/casts.hpp>
 #include <Geode/utils/ranges.hpp>
+#include <chrono>
+#include <optional>
 #include <vector>
 #include "ModImpl.hpp"
 #include "ModPatch.hpp"
@@ -46,10 +48,42 @@ public:
     tulip::hook::HandlerMetadata m_handlerMetadata;
     tulip::hook::HookMetadata m_hookMetadata;
     tulip::hook::HookHandle m_handle = 0;
+    // when this hook was last enabled relative to other hooks
+    size_t m_enableOrder = 0;
+
+    void* m_profiledDetour = nullptr;
+    HookProfile** m_profileSlot = nullptr;
+    HookProfile m_profile;
+    // whether the profiled detour is the one currently in use
+    bool m_profiling = false;
+    // counters at the last periodic summary, only touched on the main thread
+    HookProfileInfo m_lastSummary;
 
     Result<> enable();
     Result<> disable();
 
+    /**
+     * Whether this hook targets the placeholder address used for functions
+     * that haven't been found yet. Logs a warning if so
+     */
+    bool isPlaceholder() const;
+    void enableInHandler(tulip::hook::HandlerHandle handler);
+    void disableInHandler(tulip::hook::HandlerHandle handler);
+
+    /**
+     * Enable many hooks at once. Hooks are grouped by the function they
+     * hook, so each handler is looked up (or created) once per batch, and
+     * a single summary is logged instead of a line per hook. Failures are
+     * logged under the hook's owner
+     * @returns The number of hooks that failed to enable
+     */
+    static size_t enableBatch(std::vector<Hook::Impl*> hooks);
+    /**
+     * Disable many hooks at once, see enableBatch
+     * @returns The number of hooks that failed to disable
+     */
+    static size_t disableBatch(std::vector<Hook::Impl*> hooks);
+
     uintptr_t getAddress() const;
     std::string_view getDisplayName() const;
     matjson::Value getRuntimeInfo() const;
@@ -60,6 +94,23 @@ public:
 
     Result<> updateHookMetadata();
 
+    void setProfiledDetour(void* detour, HookProfile** profileSlot);
+    std::optional<HookProfileInfo> getProfileInfo() const;
+    Result<> setProfiling(bool profiling);
+
+    struct ProfilerState;
+    static ProfilerState& getProfilerState();
+
+    static void setProfilingEnabled(bool enabled);
+    static bool isProfilingEnabled();
+    static std::chrono::nanoseconds getProfilingOverhead();
+    static void resetProfiles();
+    /**
+     * Logs a summary of the most expensive hooks every so often while
+     * profiling is enabled. Called every frame
+     */
+    static void updateProfiling();
+
     friend class Hook;
     friend class Mod;
 };
@@ -8,7 +8,12 @@
 #include <hash/hash.hpp>
 #include <Geode/utils/JsonValidation.hpp>
 #include <Geode/loader/Mod.hpp>
+#include <internal/MappedFile.hpp>
+#include <about.hpp>
 
+#include "ModMetadataImpl.hpp"
+
+#include <cstring>
 #include <thread>
 
 #ifdef GEODE_IS_WINDOWS
@@ -48,11 +53,20 @@ IndexUpdateFilter::IndexUpdateFilter() {}
 
 // IndexItem
 
+class IndexSnapshot;
+struct IndexSnapshotRecord;
+
 class IndexItem::Impl final {
 private:
     ghc::filesystem::path m_rootPath;
     ghc::filesystem::path m_path;
     ModMetadata m_metadata;
+    // Items loaded from the index snapshot only parse their mod.json once 
+    // the metadata is first asked for; until then, this keeps the snapshot 
+    // the record lives in mapped
+    std::shared_ptr<IndexSnapshot> m_snapshot;
+    IndexSnapshotRecord const* m_record = nullptr;
+    std::mutex m_metadataMutex;
     std::string m_downloadURL;
     std::string m_downloadHash;
     std::unordered_set<PlatformID> m_platforms;
@@ -70,8 +84,25 @@ public:
         ghc::filesystem::path const& rootDir,
         ghc::filesystem::path const& dir
     );
+    /**
+     * Create IndexItem from a record in the index snapshot
+     */
+    static std::shared_ptr<IndexItem> createFromSnapshot(
+        std::shared_ptr<IndexSnapshot> const& snapshot,
+        IndexSnapshotRecord const& record,
+        ghc::filesystem::path const& rootDir
+    );
 
-    bool isInstalled() const;
+    /**
+     * Get the snapshot record of an item whose metadata hasn't been parsed 
+     * yet, if there is one
+     */
+    static std::pair<std::shared_ptr<IndexSnapshot>, IndexSnapshotRecord const*> getUnparsedRecord(
+        IndexItemHandle const& item
+    );
+
+    ModMetadata const& getMetadata();
+    bool isInstalled();
 };
 
 IndexItem::IndexItem() : m_impl(std::make_unique<Impl>()) {}
@@ -86,7 +117,11 @@ ghc::filesystem::path IndexItem::getPath() const {
 }
 
 ModMetadata IndexItem::getMetadata() const {
-    return m_impl->m_metadata;
+    return m_impl->getMetadata();
+}
+
+ModMetadata const& IndexItem::getMetadataRef() const {
+    return m_impl->getMetadata();
 }
 
 std::string IndexItem::getDownloadURL() const {
@@ -115,6 +150,9 @@ bool IndexItem::isInstalled() const {
 
 #if defined(GEODE_EXPOSE_SECRET_INTERNALS_IN_HEADERS_DO_NOT_DEFINE_PLEASE)
 void IndexItem::setMetadata(ModMetadata const& value) {
+    std::unique_lock lock(m_impl->m_metadataMutex);
+    m_impl->m_snapshot = nullptr;
+    m_impl->m_record = nullptr;
     m_impl->m_metadata = value;
 }
 
@@ -187,22 +225,421 @@ Result<IndexItemHandle> IndexItem::Impl::create(ghc::filesystem::path const& roo
     return Ok(item);
 }
 
-bool IndexItem::Impl::isInstalled() const {
+bool IndexItem::Impl::isInstalled() {
     if (m_isInstalled) {
         return true;
     }
-    if (!Loader::get()->isModInstalled(m_metadata.getID())) {
+    auto metadata = this->getMetadata();
+    if (!Loader::get()->isModInstalled(metadata.getID())) {
         return false;
     }
-    auto installed = Loader::get()->getInstalledMod(m_metadata.getID());
-    if (installed->getVersion() != m_metadata.getVersion()) {
+    auto installed = Loader::get()->getInstalledMod(metadata.getID());
+    if (installed->getVersion() != metadata.getVersion()) {
         return false;
     }
     return true;
 }
 
+// Snapshot
+
+// The parsed index is cached in a single binary file so that startup doesn't 
+// have to read and validate every entry.json and mod.json in the tree again. 
+// It only gets rebuilt when the index commit hash changes. Every string lives 
+// in one deduplicated table that records point into by offset, so the file 
+// is used straight from its mapping without any deserialization step
+
+static constexpr char SNAPSHOT_MAGIC[8] = { 'G', 'E', 'O', 'D', 'E', 'I', 'D', 'X' };
+static constexpr uint32_t SNAPSHOT_VERSION = 1;
+// Size of strings that aren't present at all (as opposed to empty)
+static constexpr uint32_t SNAPSHOT_ABSENT = UINT32_MAX;
+
+struct IndexSnapshotString {
+    uint32_t offset;
+    uint32_t size;
+};
+
+struct IndexSnapshotHeader {
+    char magic[8];
+    uint32_t version;
+    uint32_t recordCount;
+    uint32_t recordsOffset;
+    uint32_t stringsOffset;
+    uint32_t stringsSize;
+    IndexSnapshotString commitHash;
+    IndexSnapshotString loaderVersion;
+};
+
+struct IndexSnapshotRecord {
+    enum Flags : uint32_t {
+        Featured = 1 << 0,
+        CheckUnknownKeys = 1 << 1,
+    };
+
+    IndexSnapshotString modID;
+    // Name of the version directory under mods-v2/<id>/
+    IndexSnapshotString versionDir;
+    IndexSnapshotString version;
+    // mod.json, minified
+    IndexSnapshotString modJSON;
+    IndexSnapshotString downloadURL;
+    IndexSnapshotString downloadHash;
+    // Newline-separated lists
+    IndexSnapshotString platforms;
+    IndexSnapshotString tags;
+    IndexSnapshotString details;
+    IndexSnapshotString changelog;
+    IndexSnapshotString supportInfo;
+    uint32_t flags;
+};
+
+class IndexSnapshot final {
+private:
+    MappedFile m_file;
+    IndexSnapshotHeader const* m_header = nullptr;
+    IndexSnapshotRecord const* m_records = nullptr;
+    char const* m_strings = nullptr;
+
+    IndexSnapshot(MappedFile&& file) : m_file(std::move(file)) {}
+
+    bool isValid(IndexSnapshotString const& str) const;
+
+public:
+    using Items = std::unordered_map<std::string, std::map<VersionInfo, IndexItemHandle>>;
+
+    /**
+     * Load the items of a snapshot, provided it was built from the given 
+     * index commit by this loader version
+     */
+    static Result<Items> load(ghc::filesystem::path const& path, std::string const& commitHash);
+    static Result<> write(
+        ghc::filesystem::path const& path, std::string const& commitHash, Items const& items
+    );
+
+    std::string_view get(IndexSnapshotString const& str) const;
+    std::optional<std::string> getOptional(IndexSnapshotString const& str) const;
+
+    Result<ModMetadata> createMetadata(IndexSnapshotRecord const& record, ghc::filesystem::path const& dir) const;
+};
+
+static ghc::filesystem::path getSnapshotPath(std::string const& commitHash) {
+    // every commit gets its own file, since items carried over from the 
+    // previous snapshot keep it mapped and Windows can't replace a file that 
+    // is mapped
+    return dirs::getIndexDir() / fmt::format(".snapshot-{}", commitHash.substr(0, 16));
+}
+
+static void removeSnapshots(ghc::filesystem::path const& keep = ghc::filesystem::path()) {
+    std::error_code ec;
+    for (auto& entry : ghc::filesystem::directory_iterator(dirs::getIndexDir(), ec)) {
+        auto name = entry.path().filename().string();
+        if (name.starts_with(".snapshot") && entry.path() != keep) {
+            // snapshots that are still mapped can't be removed on Windows, 
+            // so they're just cleaned up on a later write
+            std::error_code removeEc;
+            ghc::filesystem::remove(entry.path(), removeEc);
+        }
+    }
+}
+
+static std::string getSnapshotLoaderVersion() {
+    // items are validated against the loader at build time, so snapshots from 
+    // another loader version might contain mods this one would reject
+    return fmt::format("{}-{}", about::getLoaderVersionStr(), GEODE_PLATFORM_SHORT_IDENTIFIER);
+}
+
+bool IndexSnapshot::isValid(IndexSnapshotString const& str) const {
+    if (str.size == SNAPSHOT_ABSENT) {
+        return true;
+    }
+    return str.offset <= m_header->stringsSize && str.size <= m_header->stringsSize - str.offset;
+}
+
+std::string_view IndexSnapshot::get(IndexSnapshotString const& str) const {
+    if (str.size == SNAPSHOT_ABSENT) {
+        return std::string_view();
+    }
+    return std::string_view(m_strings + str.offset, str.size);
+}
+
+std::optional<std::string> IndexSnapshot::getOptional(IndexSnapshotString const& str) const {
+    if (str.size == SNAPSHOT_ABSENT) {
+        return std::nullopt;
+    }
+    return std::string(this->get(str));
+}
+
+Result<IndexSnapshot::Items> IndexSnapshot::load(
+    ghc::filesystem::path const& path, std::string const& commitHash
+) {
+    GEODE_UNWRAP_INTO(auto file, MappedFile::create(path));
+    auto snapshot = std::shared_ptr<IndexSnapshot>(new IndexSnapshot(std::move(file)));
+    auto data = snapshot->m_file.data();
+    auto size = snapshot->m_file.size();
+
+    if (size < sizeof(IndexSnapshotHeader)) {
+        return Err("Snapshot is truncated");
+    }
+    auto header = reinterpret_cast<IndexSnapshotHeader const*>(data);
+    if (std::memcmp(header->magic, SNAPSHOT_MAGIC, sizeof(SNAPSHOT_MAGIC)) != 0) {
+        return Err("Snapshot has an invalid header");
+    }
+    if (header->version != SNAPSHOT_VERSION) {
+        return Err("Snapshot has an outdated format");
+    }
+    if (
+        header->recordsOffset % alignof(IndexSnapshotRecord) != 0 ||
+        header->recordsOffset > size ||
+        header->recordCount > (size - header->recordsOffset) / sizeof(IndexSnapshotRecord) ||
+        header->stringsOffset > size ||
+        header->stringsSize > size - header->stringsOffset
+    ) {
+        return Err("Snapshot is truncated");
+    }
+    snapshot->m_header = header;
+    snapshot->m_records = reinterpret_cast<IndexSnapshotRecord const*>(data + header->recordsOffset);
+    snapshot->m_strings = reinterpret_cast<char const*>(data + header->stringsOffset);
+
+    if (!snapshot->isValid(header->commitHash) || !snapshot->isValid(header->loaderVersion)) {
+        return Err("Snapshot is corrupted");
+    }
+    if (snapshot->get(header->commitHash) != commitHash) {
+        return Err("Snapshot is from another index commit");
+    }
+    if (snapshot->get(header->loaderVersion) != getSnapshotLoaderVersion()) {
+        return Err("Snapshot is from another loader version");
+    }
+
+    auto entriesRoot = dirs::getIndexDir() / "v0" / "mods-v2";
+
+    Items items;
+    for (uint32_t i = 0; i < header->recordCount; i++) {
+        auto const& record = snapshot->m_records[i];
+        for (auto str : {
+            record.modID, record.versionDir, record.version, record.modJSON,
+            record.downloadURL, record.downloadHash, record.platforms, record.tags,
+            record.details, record.changelog, record.supportInfo
+        }) {
+            if (!snapshot->isValid(str)) {
+                return Err("Snapshot is corrupted");
+            }
+        }
+
+        GEODE_UNWRAP_INTO(
+            auto version, VersionInfo::parse(snapshot->get(record.version))
+                .expect("Snapshot has an invalid version: {error}")
+        );
+
+        auto modID = std::string(snapshot->get(record.modID));
+        items[modID].insert({
+            version, IndexItem::Impl::createFromSnapshot(snapshot, record, entriesRoot / modID)
+        });
+    }
+    return Ok(items);
+}
+
+Result<> IndexSnapshot::write(
+    ghc::filesystem::path const& path, std::string const& commitHash, Items const& items
+) {
+    ByteVector strings;
+    std::unordered_map<std::string, IndexSnapshotString> stringTable;
+    auto addString = [&](std::string const& str) {
+        auto it = stringTable.find(str);
+        if (it != stringTable.end()) {
+            return it->second;
+        }
+        auto ref = IndexSnapshotString {
+            static_cast<uint32_t>(strings.size()),
+            static_cast<uint32_t>(str.size())
+        };
+        strings.insert(strings.end(), str.begin(), str.end());
+        stringTable.insert({ str, ref });
+        return ref;
+    };
+    auto addOptional = [&](std::optional<std::string> const& str) {
+        if (!str) {
+            return IndexSnapshotString { 0, SNAPSHOT_ABSENT };
+        }
+        return addString(*str);
+    };
+
+    IndexSnapshotHeader header {};
+    std::memcpy(header.magic, SNAPSHOT_MAGIC, sizeof(SNAPSHOT_MAGIC));
+    header.version = SNAPSHOT_VERSION;
+    header.commitHash = addString(commitHash);
+    header.loaderVersion = addString(getSnapshotLoaderVersion());
+
+    std::vector<IndexSnapshotRecord> records;
+    for (auto& [modID, versions] : items) {
+        for (auto& [version, item] : versions) {
+            std::vector<std::string> platforms;
+            for (auto& plat : item->getAvailablePlatforms()) {
+                platforms.push_back(PlatformID::toShortString(plat.m_value));
+            }
+            auto tags = item->getTags();
+
+            IndexSnapshotRecord record {};
+            record.modID = addString(modID);
+            record.versionDir = addString(item->getPath().filename().string());
+            record.version = addString(version.toString());
+            record.downloadURL = addString(item->getDownloadURL());
+            record.downloadHash = addString(item->getPackageHash());
+            record.platforms = addString(ranges::join(platforms, "\n"));
+            record.tags = addString(ranges::join(
+                std::vector<std::string>(tags.begin(), tags.end()), "\n"
+            ));
+            // items carried over from an older snapshot are copied without 
+            // ever parsing their mod.json
+            auto [source, sourceRecord] = IndexItem::Impl::getUnparsedRecord(item);
+            if (sourceRecord) {
+                record.modJSON = addString(std::string(source->get(sourceRecord->modJSON)));
+                record.details = addOptional(source->getOptional(sourceRecord->details));
+                record.changelog = addOptional(source->getOptional(sourceRecord->changelog));
+                record.supportInfo = addOptional(source->getOptional(sourceRecord->supportInfo));
+            }
+            else {
+                auto metadata = item->getMetadata();
+                record.modJSON = addString(metadata.getRawJSON().dump(matjson::NO_INDENTATION));
+                record.details = addOptional(metadata.getDetails());
+                record.changelog = addOptional(metadata.getChangelog());
+                record.supportInfo = addOptional(metadata.getSupportInfo());
+            }
+            record.flags = 0;
+            if (item->isFeatured()) {
+                record.flags |= IndexSnapshotRecord::Featured;
+            }
+            if (&version == &versions.rbegin()->first) {
+                record.flags |= IndexSnapshotRecord::CheckUnknownKeys;
+            }
+            records.push_back(record);
+        }
+    }
+
+    header.recordCount = static_cast<uint32_t>(records.size());
+    header.recordsOffset = sizeof(IndexSnapshotHeader);
+    header.stringsOffset = header.recordsOffset + header.recordCount * sizeof(IndexSnapshotRecord);
+    header.stringsSize = static_cast<uint32_t>(strings.size());
+
+    ByteVector data(header.stringsOffset + strings.size());
+    std::memcpy(data.data(), &header, sizeof(header));
+    if (!records.empty()) {
+        std::memcpy(
+            data.data() + header.recordsOffset, records.data(),
+            records.size() * sizeof(IndexSnapshotRecord)
+        );
+    }
+    if (!strings.empty()) {
+        std::memcpy(data.data() + header.stringsOffset, strings.data(), strings.size());
+    }
+
+    // write next to the old one and swap it in so a crash can never leave a 
+    // half-written snapshot behind
+    auto tempPath = path;
+    tempPath += ".tmp";
+    GEODE_UNWRAP(file::writeBinary(tempPath, data));
+    std::error_code ec;
+    ghc::filesystem::rename(tempPath, path, ec);
+    if (ec) {
+        return Err("Unable to replace snapshot: {}", ec.message());
+    }
+    removeSnapshots(path);
+    return Ok();
+}
+
+// TODO: gross hack :3 (ctrl+f this comment to find the other part)
+extern thread_local bool s_jsonCheckerShouldCheckUnknownKeys;
+
+Result<ModMetadata> IndexSnapshot::createMetadata(
+    IndexSnapshotRecord const& record, ghc::filesystem::path const& dir
+) const {
+    std::string error;
+    auto json = matjson::parse(std::string(this->get(record.modJSON)), error);
+    if (error.size() > 0) {
+        return Err("Unable to parse mod.json: {}", error);
+    }
+
+    s_jsonCheckerShouldCheckUnknownKeys = record.flags & IndexSnapshotRecord::CheckUnknownKeys;
+    auto res = ModMetadata::create(json.value());
+    s_jsonCheckerShouldCheckUnknownKeys = true;
+    GEODE_UNWRAP_INTO(auto metadata, res);
+
+    auto& impl = ModMetadataImpl::getImpl(metadata);
+    impl.m_path = dir / "mod.json";
+    impl.m_details = this->getOptional(record.details);
+    impl.m_changelog = this->getOptional(record.changelog);
+    impl.m_supportInfo = this->getOptional(record.supportInfo);
+    return Ok(metadata);
+}
+
+std::shared_ptr<IndexItem> IndexItem::Impl::createFromSnapshot(
+    std::shared_ptr<IndexSnapshot> const& snapshot,
+    IndexSnapshotRecord const& record,
+    ghc::filesystem::path const& rootDir
+) {
+    auto item = std::make_shared<IndexItem>();
+    auto impl = item->m_impl.get();
+    impl->m_rootPath = rootDir;
+    impl->m_path = rootDir / std::string(snapshot->get(record.versionDir));
+    impl->m_downloadURL = snapshot->get(record.downloadURL);
+    impl->m_downloadHash = snapshot->get(record.downloadHash);
+    for (auto& plat : utils::string::split(std::string(snapshot->get(record.platforms)), "\n")) {
+        impl->m_platforms.insert(PlatformID::from(plat));
+    }
+    for (auto& tag : utils::string::split(std::string(snapshot->get(record.tags)), "\n")) {
+        impl->m_tags.insert(tag);
+    }
+    impl->m_isFeatured = record.flags & IndexSnapshotRecord::Featured;
+    impl->m_snapshot = snapshot;
+    impl->m_record = &record;
+    return item;
+}
+
+std::pair<std::shared_ptr<IndexSnapshot>, IndexSnapshotRecord const*> IndexItem::Impl::getUnparsedRecord(
+    IndexItemHandle const& item
+) {
+    std::unique_lock lock(item->m_impl->m_metadataMutex);
+    return { item->m_impl->m_snapshot, item->m_impl->m_record };
+}
+
+ModMetadata const& IndexItem::Impl::getMetadata() {
+    std::unique_lock lock(m_metadataMutex);
+    if (m_snapshot) {
+        auto res = m_snapshot->createMetadata(*m_record, m_path);
+        if (res) {
+            m_metadata = res.unwrap();
+        }
+        else {
+            log::error("Unable to read {} from the index snapshot: {}", m_path, res.unwrapErr());
+            m_metadata = ModMetadata(m_rootPath.filename().string());
+        }
+        m_snapshot = nullptr;
+        m_record = nullptr;
+    }
+    return m_metadata;
+}
+
 // Helpers
 
+// The index lives in a GitHub repository. Both of these can be pointed at a 
+// local server through launch arguments to test index updates
+static std::string getIndexAPIURL() {
+    return Loader::get()->getLaunchArgument("index-api-url")
+        .value_or("https://api.github.com/repos/geode-sdk/mods");
+}
+
+static std::string getIndexRawURL() {
+    return Loader::get()->getLaunchArgument("index-raw-url")
+        .value_or("https://raw.githubusercontent.com/geode-sdk/mods");
+}
+
+static void saveIndexVersion(std::string const& commitHash, std::string const& etag) {
+    if (!commitHash.empty()) {
+        (void)file::writeString(dirs::getIndexDir() / ".checksum", commitHash);
+    }
+    if (!etag.empty()) {
+        (void)file::writeString(dirs::getIndexDir() / ".etag", etag);
+    }
+}
+
 static Result<> flattenGithubRepo(ghc::filesystem::path const& dir) {
     // github zipballs have a folder at root, but we already have our 
     // own folder for that so let's just bring everything from that 
@@ -247,10 +684,21 @@ public:
     using ItemVersions = std::map<VersionInfo, IndexItemHandle>;
 
 private:
-    std::unordered_map<
-        IndexItemHandle,
-        utils::web::SentAsyncWebRequestHandle
-    > m_runningInstallations;
+    // State of an install list being downloaded. Only ever touched from the 
+    // GD thread, which is where all web request callbacks run
+    struct Installation {
+        IndexInstallList list;
+        // Running downloads, by index in the list
+        std::vector<utils::web::SentAsyncWebRequestHandle> requests;
+        // Download progress of each item in the list, from 0 to 1
+        std::vector<double> progress;
+        size_t nextIndex = 0;
+        size_t running = 0;
+        size_t finished = 0;
+        bool failed = false;
+    };
+
+    std::unordered_map<IndexItemHandle, std::shared_ptr<Installation>> m_runningInstallations;
     std::atomic<bool> m_isUpToDate = false;
     std::atomic<bool> m_updating = false;
     std::atomic<bool> m_triedToUpdate = false;
@@ -260,10 +708,24 @@ private:
     friend class Index;
 
     void cleanupItems();
-    void downloadIndex(std::string commitHash = "");
+    void downloadIndex(std::string commitHash = "", std::string etag = "");
+    void downloadIndexChanges(std::string const& oldHash, std::string const& newHash, std::string const& etag);
+    Result<> applyIndexChanges(
+        std::string const& response, std::string const& oldHash, std::string const& newHash,
+        std::string const& etag, std::chrono::steady_clock::time_point startTime
+    );
     void checkForUpdates();
+    Result<IndexSnapshot::Items> loadItemsFromTree(
+        IndexSnapshot::Items const& reuse = {}, std::unordered_set<std::string> const& changed = {}
+    );
     void updateFromLocalTree();
-    void installNext(size_t index, IndexInstallList const& list);
+    void beginInstallation(IndexInstallList const& list);
+    void startDownloads(std::shared_ptr<Installation> installation);
+    void downloadItem(std::shared_ptr<Installation> installation, size_t index);
+    void fetchItem(std::shared_ptr<Installation> installation, size_t index);
+    void finishItem(std::shared_ptr<Installation> installation, size_t index);
+    void failInstallation(std::shared_ptr<Installation> installation, std::string const& error);
+    void postInstallProgress(std::shared_ptr<Installation> const& installation, std::string const& status);
 
 public:
     Impl() {
@@ -309,18 +771,19 @@ bool Index::hasTriedToUpdate() const {
     return m_impl->m_triedToUpdate;
 }
 
-void Index::Impl::downloadIndex(std::string commitHash) {
+void Index::Impl::downloadIndex(std::string commitHash, std::string etag) {
     log::debug("Downloading index");
 
     IndexUpdateEvent(UpdateProgress(0, "Beginning download")).post();
 
     auto targetFile = dirs::getTempDir() / "updated-index.zip";
+    auto startTime = std::chrono::steady_clock::now();
 
     web::AsyncWebRequest()
         .join("index-download")
         .fetch("https://github.com/geode-sdk/mods/zipball/main")
         .into(targetFile)
-        .then([this, targetFile, commitHash](auto) {
+        .then([this, targetFile, commitHash, etag, startTime](auto) {
             std::thread([=, this]() {
                 thread::setName("Index Update");
 
@@ -351,12 +814,20 @@ void Index::Impl::downloadIndex(std::string commitHash) {
 
                 // remove the directory github adds to the root of the zip
                 (void)flattenGithubRepo(targetDir);
-                if (!commitHash.empty()) {
-                    auto const checksumPath = dirs::getIndexDir() / ".checksum";
-                    (void)file::writeString(checksumPath, commitHash);
-                }
+                // the tree changed, so the snapshot of the old one is useless 
+                // even if the commit hash isn't known
+                removeSnapshots();
+                saveIndexVersion(commitHash, etag);
 
                 this->updateFromLocalTree();
+
+                log::info(
+                    "Downloaded full index in {}ms ({} bytes transferred)",
+                    std::chrono::duration_cast<std::chrono::milliseconds>(
+                        std::chrono::steady_clock::now() - startTime
+                    ).count(),
+                    ghc::filesystem::file_size(targetFile, ec)
+                );
             }).detach();
         })
         .expect([](std::string const& err) {
@@ -394,14 +865,23 @@ void Index::Impl::checkForUpdates() {
     // not using saved values for this one as we don't want to refetch 
     // index even if the game crashes
     auto oldSHA = file::readString(checksum).unwrapOr("");
+    // sending back the ETag of the last response lets GitHub answer with an 
+    // empty 304 if nothing changed, which doesn't count towards rate limits
+    auto oldETag = file::readString(dirs::getIndexDir() / ".etag")
+        .unwrapOr(fmt::format("\"{}\"", oldSHA));
     web::AsyncWebRequest()
         .join("index-update")
         .userAgent("github_api/1.0")
-        .header(fmt::format("If-None-Match: \"{}\"", oldSHA))
+        .header(fmt::format("If-None-Match: {}", oldETag))
         .header("Accept: application/vnd.github.sha")
-        .fetch("https://api.github.com/repos/geode-sdk/mods/commits/main")
+        .fetch(getIndexAPIURL() + "/commits/main")
         .text()
-        .then([this, checksum, oldSHA](std::string const& newSHA) {
+        .then([this, checksum, oldSHA](web::SentAsyncWebRequest& req, std::string const& newSHA) {
+            auto etag = req.getResponseHeader("ETag");
+            if (etag.empty()) {
+                etag = req.getResponseHeader("etag");
+            }
+
             // check if should just be updated from local cache
             if (
                 // if no new hash was given (rate limited) or the new hash is the 
@@ -415,9 +895,16 @@ void Index::Impl::checkForUpdates() {
                     this->updateFromLocalTree();
                 }).detach();
             }
+            // if there's a local copy to patch, only fetch what changed
+            else if (
+                !oldSHA.empty() && !newSHA.empty() &&
+                ghc::filesystem::exists(dirs::getIndexDir() / "v0" / "config.json")
+            ) {
+                this->downloadIndexChanges(oldSHA, newSHA, etag);
+            }
             // otherwise save hash and download source
             else {
-                this->downloadIndex(newSHA);
+                this->downloadIndex(newSHA, etag);
             }
         })
         .expect([](std::string const& err) {
@@ -428,34 +915,257 @@ void Index::Impl::checkForUpdates() {
         });
 }
 
-// TODO: gross hack :3 (ctrl+f this comment to find the other part)
-extern bool s_jsonCheckerShouldCheckUnknownKeys;
-void Index::Impl::updateFromLocalTree() {
-    log::debug("Updating local index cache");
-    log::pushNest();
-    std::unique_lock<std::mutex> lock(m_itemsMutex);
+void Index::Impl::downloadIndexChanges(
+    std::string const& oldHash, std::string const& newHash, std::string const& etag
+) {
+    log::debug("Fetching index changes since {}", oldHash);
+
+    IndexUpdateEvent(UpdateProgress(0, "Fetching changes")).post();
+
+    auto startTime = std::chrono::steady_clock::now();
+
+    // the comparison lists every changed file along with its blob hash, so it 
+    // doubles as the manifest of what needs to be fetched
+    web::AsyncWebRequest()
+        .join("index-changes")
+        .userAgent("github_api/1.0")
+        .header("Accept: application/vnd.github+json")
+        .fetch(fmt::format("{}/compare/{}...{}", getIndexAPIURL(), oldHash, newHash))
+        .text()
+        .then([this, oldHash, newHash, etag, startTime](std::string const& response) {
+            std::thread([=, this]() {
+                thread::setName("Index Update");
+
+                auto res = this->applyIndexChanges(response, oldHash, newHash, etag, startTime);
+                if (!res) {
+                    log::warn("Unable to update index incrementally: {}", res.unwrapErr());
+                    Loader::get()->queueInMainThread([this, newHash, etag] {
+                        this->downloadIndex(newHash, etag);
+                    });
+                }
+            }).detach();
+        })
+        .expect([this, newHash, etag](std::string const& err) {
+            log::warn("Unable to fetch index changes: {}", err);
+            this->downloadIndex(newHash, etag);
+        });
+}
+
+Result<> Index::Impl::applyIndexChanges(
+    std::string const& response, std::string const& oldHash, std::string const& newHash,
+    std::string const& etag, std::chrono::steady_clock::time_point startTime
+) {
+    struct FileChange {
+        std::string path;
+        std::string hash;
+        bool removed = false;
+        ByteVector data;
+    };
+
+    std::string error;
+    auto json = matjson::parse(response, error);
+    if (error.size() > 0) {
+        return Err("Unable to parse changes: {}", error);
+    }
+    auto comparison = json.value();
+
+    // anything other than the new commit being strictly ahead (like a force 
+    // push) can't be applied on top of the local copy
+    if (
+        !comparison.contains("status") || !comparison["status"].is_string() ||
+        comparison["status"].as_string() != "ahead"
+    ) {
+        return Err("New index is not ahead of the local copy");
+    }
+    if (!comparison.contains("files") || !comparison["files"].is_array()) {
+        return Err("Comparison has no file list");
+    }
+    // GitHub truncates the file list of large comparisons
+    auto const& files = comparison["files"].as_array();
+    if (files.size() >= 300) {
+        return Err("Too many changes");
+    }
+
+    auto isSafePath = [](std::string const& path) {
+        for (auto& part : utils::string::split(path, "/")) {
+            if (part.empty() || part == "." || part == "..") {
+                return false;
+            }
+        }
+        return !path.empty();
+    };
+
+    std::vector<FileChange> changes;
+    for (auto& file : files) {
+        if (
+            !file.contains("filename") || !file["filename"].is_string() ||
+            !file.contains("status") || !file["status"].is_string()
+        ) {
+            return Err("Comparison has an invalid file entry");
+        }
+        auto path = file["filename"].as_string();
+        auto status = file["status"].as_string();
+        if (!isSafePath(path)) {
+            return Err("Comparison has an invalid path: {}", path);
+        }
+
+        if (status == "renamed" && file.contains("previous_filename")) {
+            auto previous = file["previous_filename"].as_string();
+            if (!isSafePath(previous)) {
+                return Err("Comparison has an invalid path: {}", previous);
+            }
+            changes.push_back({ previous, "", true });
+        }
+        if (status == "removed") {
+            changes.push_back({ path, "", true });
+        }
+        else {
+            if (!file.contains("sha") || !file["sha"].is_string()) {
+                return Err("Comparison has no hash for {}", path);
+            }
+            changes.push_back({ path, file["sha"].as_string(), false });
+        }
+    }
 
+    std::vector<FileChange*> downloads;
+    for (auto& change : changes) {
+        if (!change.removed) {
+            downloads.push_back(&change);
+        }
+    }
+
+    // fetch everything before touching the local copy, so that a failed 
+    // download leaves it intact
+    std::atomic<size_t> nextDownload = 0;
+    std::atomic<size_t> finishedDownloads = 0;
+    std::atomic<size_t> bytesTransferred = response.size();
+    std::atomic<bool> failed = false;
+    std::mutex errorMutex;
+    std::string downloadError;
+
+    auto downloadChanges = [&]() {
+        while (!failed) {
+            auto i = nextDownload++;
+            if (i >= downloads.size()) {
+                break;
+            }
+            auto& change = *downloads[i];
+
+            auto res = web::fetchBytes(fmt::format("{}/{}/{}", getIndexRawURL(), newHash, change.path));
+            if (res) {
+                change.data = res.unwrap();
+                bytesTransferred += change.data.size();
+            }
+            if (!res || calculateGitBlobHash(change.data.data(), change.data.size()) != change.hash) {
+                std::lock_guard lock(errorMutex);
+                if (!failed.exchange(true)) {
+                    downloadError = res ?
+                        fmt::format("Hash mismatch for {}", change.path) :
+                        fmt::format("Unable to fetch {}: {}", change.path, res.unwrapErr());
+                }
+                break;
+            }
+
+            auto done = ++finishedDownloads;
+            Loader::get()->queueInMainThread([done, total = downloads.size()] {
+                IndexUpdateEvent(UpdateProgress(
+                    static_cast<uint8_t>(done * 100 / total), "Downloading changes"
+                )).post();
+            });
+        }
+    };
+
+    size_t workerCount = std::min<size_t>(8, downloads.size());
+    std::vector<std::thread> workers;
+    for (size_t i = 1; i < workerCount; i++) {
+        workers.emplace_back(downloadChanges);
+    }
+    downloadChanges();
+    for (auto& worker : workers) {
+        worker.join();
+    }
+    if (failed) {
+        return Err(downloadError);
+    }
+
+    auto indexRoot = dirs::getIndexDir() / "v0";
+    std::unordered_set<std::string> changedMods;
+    for (auto& change : changes) {
+        auto path = indexRoot / change.path;
+        if (change.removed) {
+            std::error_code ec;
+            ghc::filesystem::remove(path, ec);
+        }
+        else {
+            GEODE_UNWRAP(file::createDirectoryAll(path.parent_path()));
+            GEODE_UNWRAP(file::writeBinary(path, change.data));
+        }
+        auto parts = utils::string::split(change.path, "/");
+        if (parts.size() > 2 && parts[0] == "mods-v2") {
+            changedMods.insert(parts[1]);
+        }
+    }
+    saveIndexVersion(newHash, etag);
+
+    log::debug("Applied {} index changes, re-parsing {} mods", changes.size(), changedMods.size());
     Loader::get()->queueInMainThread([](){
         IndexUpdateEvent(UpdateProgress(100, "Updating local cache")).post();
     });
-    // delete old items
-    m_items.clear();
-    lock.unlock();
 
+    // everything that wasn't touched can be taken from the snapshot of the 
+    // previous version as-is
+    auto previous = IndexSnapshot::load(getSnapshotPath(oldHash), oldHash)
+        .unwrapOr(IndexSnapshot::Items());
+    GEODE_UNWRAP_INTO(auto items, this->loadItemsFromTree(previous, changedMods));
+    previous.clear();
+
+    auto writeRes = IndexSnapshot::write(getSnapshotPath(newHash), newHash, items);
+    if (!writeRes) {
+        log::warn("Unable to save index snapshot: {}", writeRes.unwrapErr());
+    }
+
+    {
+        std::scoped_lock lock(m_itemsMutex);
+        m_items = std::move(items);
+    }
+    m_isUpToDate = true;
+
+    log::info(
+        "Updated index in {}ms ({} files changed, {} mods re-parsed, {} bytes transferred)",
+        std::chrono::duration_cast<std::chrono::milliseconds>(
+            std::chrono::steady_clock::now() - startTime
+        ).count(),
+        changes.size(), changedMods.size(), bytesTransferred.load()
+    );
+
+    Loader::get()->queueInMainThread([](){
+        IndexUpdateEvent(UpdateFinished()).post();
+    });
+    return Ok();
+}
+
+Result<IndexSnapshot::Items> Index::Impl::loadItemsFromTree(
+    IndexSnapshot::Items const& reuse, std::unordered_set<std::string> const& changed
+) {
     auto indexRoot = dirs::getIndexDir() / "v0";
     auto entriesRoot = indexRoot / "mods-v2";
 
-    auto configRes = file::readJson(indexRoot / "config.json");
-    if (!configRes) {
-        IndexUpdateEvent("Unable to read index config").post();
-        return;
-    }
-    auto config = configRes.unwrap();
+    GEODE_UNWRAP_INTO(
+        auto config, file::readJson(indexRoot / "config.json")
+            .expect("Unable to read index config")
+    );
+    IndexSnapshot::Items items;
 
     JsonChecker checker(config);
     auto root = checker.root("[index/config.json]").obj();
 
     for (auto& [modID, entry] : root.has("entries").items()) {
+        // mods an incremental update didn't touch keep their parsed versions
+        if (!changed.contains(modID) && reuse.contains(modID)) {
+            items.insert({ modID, reuse.at(modID) });
+            continue;
+        }
+
         auto versions = entry.obj().has("versions");
         for (auto& version : entry.obj().has("versions").iterate()) {
             s_jsonCheckerShouldCheckUnknownKeys =
@@ -472,13 +1182,59 @@ void Index::Impl::updateFromLocalTree() {
             auto add = addRes.unwrap();
             auto metadata = add->getMetadata();
 
-            lock.lock();
-            m_items[modID].insert({metadata.getVersion(),
+            items[modID].insert({metadata.getVersion(),
                 add
             });
-            lock.unlock();
         }
     }
+    s_jsonCheckerShouldCheckUnknownKeys = true;
+
+    return Ok(items);
+}
+
+void Index::Impl::updateFromLocalTree() {
+    log::debug("Updating local index cache");
+    log::pushNest();
+    std::unique_lock<std::mutex> lock(m_itemsMutex);
+
+    Loader::get()->queueInMainThread([](){
+        IndexUpdateEvent(UpdateProgress(100, "Updating local cache")).post();
+    });
+    // delete old items
+    m_items.clear();
+    lock.unlock();
+
+    auto commitHash = file::readString(dirs::getIndexDir() / ".checksum").unwrapOr("");
+    auto snapshotPath = getSnapshotPath(commitHash);
+
+    IndexSnapshot::Items items;
+    if (auto snapshotRes = IndexSnapshot::load(snapshotPath, commitHash)) {
+        items = snapshotRes.unwrap();
+    }
+    else {
+        log::debug("Rebuilding index snapshot: {}", snapshotRes.unwrapErr());
+
+        auto treeRes = this->loadItemsFromTree();
+        if (!treeRes) {
+            auto const err = treeRes.unwrapErr();
+            log::error("Failed to read local index: {}", err);
+            Loader::get()->queueInMainThread([err] {
+                IndexUpdateEvent(UpdateFailed(err)).post();
+            });
+            log::popNest();
+            return;
+        }
+        items = treeRes.unwrap();
+
+        auto writeRes = IndexSnapshot::write(snapshotPath, commitHash, items);
+        if (!writeRes) {
+            log::warn("Unable to save index snapshot: {}", writeRes.unwrapErr());
+        }
+    }
+
+    lock.lock();
+    m_items = std::move(items);
+    lock.unlock();
 
     // mark source as finished
     m_isUpToDate = true;
@@ -602,8 +1358,8 @@ IndexItemHandle Index::getItem(
     if (m_impl->m_items.count(id)) {
         auto versions = m_impl->m_items.at(id);
         if (version) {
-            for (auto& [_, item] : ranges::reverse(m_impl->m_items.at(id))) {
-                if (version.value() == item->getMetadata().getVersion()) {
+            for (auto& [itemVersion, item] : ranges::reverse(m_impl->m_items.at(id))) {
+                if (version.value() == itemVersion) {
                     return item;
                 }
             }
@@ -620,8 +1376,8 @@ IndexItemHandle Index::getItem(
     std::scoped_lock lock(m_impl->m_itemsMutex);
     if (m_impl->m_items.count(id)) {
         // prefer most major version
-        for (auto& [_, item] : ranges::reverse(m_impl->m_items.at(id))) {
-            if (version.compare(item->getMetadata().getVersion())) {
+        for (auto& [itemVersion, item] : ranges::reverse(m_impl->m_items.at(id))) {
+            if (version.compare(itemVersion)) {
                 return item;
             }
         }
@@ -750,125 +1506,278 @@ Result<IndexInstallList> Index::getInstallList(IndexItemHandle item) const {
     return Ok(list);
 }
 
-void Index::Impl::installNext(size_t index, IndexInstallList const& list) {
-    auto postError = [this, list](std::string const& error) {
-        m_runningInstallations.erase(list.target);
-        ModInstallEvent(list.target->getMetadata().getID(), error).post();
-    };
+static ghc::filesystem::path getPartialDownloadPath(IndexItemHandle item) {
+    // The expected hash is part of the name so that a partial download is 
+    // only ever resumed into the same package
+    return dirs::getTempDir() / fmt::format(
+        "{}-{}.part",
+        item->getMetadata().getID(), item->getPackageHash().substr(0, 16)
+    );
+}
 
-    // If we're at the end of the list, move the downloaded items to mods
-    if (index >= list.list.size()) {
-        m_runningInstallations.erase(list.target);
-        // Move all downloaded files
-        for (auto& item : list.list) {
-            // If the mod is already installed, delete the old .geode file
-            if (auto mod = Loader::get()->getInstalledMod(item->getMetadata().getID())) {
-                auto res = mod->uninstall();
-                if (!res) {
-                    return postError(fmt::format(
-                        "Unable to uninstall old version of {}: {}",
-                        item->getMetadata().getID(), res.unwrapErr()
-                    ));
-                }
-            }
+void Index::Impl::beginInstallation(IndexInstallList const& list) {
+    auto installation = std::make_shared<Installation>();
+    installation->list = list;
+    installation->requests.resize(list.list.size());
+    installation->progress.resize(list.list.size(), 0.0);
+    m_runningInstallations[list.target] = installation;
+    this->startDownloads(installation);
+}
 
-            // Move the temp file
-            std::error_code ec;
-            ghc::filesystem::rename(
-                dirs::getTempDir() / (item->getMetadata().getID() + ".index"),
-                dirs::getModsDir() / (item->getMetadata().getID() + ".geode"), ec
-            );
-            if (ec) {
-                return postError(fmt::format(
-                    "Unable to move downloaded file for {}: {}",
-                    item->getMetadata().getID(), ec.message()
-                ));
-            }
-        }
+void Index::Impl::startDownloads(std::shared_ptr<Installation> installation) {
+    // Nothing is moved into the mods directory before every item in the 
+    // list has been downloaded, so downloads don't have to wait for their 
+    // dependencies and can all run side by side
+    auto maxRunning = static_cast<size_t>(std::max<int64_t>(
+        Mod::get()->getSettingValue<int64_t>("max-concurrent-downloads"), 1
+    ));
+    while (
+        !installation->failed &&
+        installation->running < maxRunning &&
+        installation->nextIndex < installation->list.list.size()
+    ) {
+        this->downloadItem(installation, installation->nextIndex++);
+    }
+}
 
-        auto const& eventModID = list.target->getMetadata().getID();
-        Loader::get()->queueInMainThread([eventModID]() {
-            ModInstallEvent(eventModID, UpdateFinished()).post();
+// Packages can be hundreds of MB, so files that are already on disk are 
+// hashed on another thread
+static void calculateHashAsync(
+    ghc::filesystem::path const& path, utils::MiniFunction<void(Result<std::string> const&)> then
+) {
+    std::thread([=] {
+        thread::setName("Package Hash");
+        auto hash = ::calculateHash(path);
+        Loader::get()->queueInMainThread([=] {
+            then(hash);
         });
+    }).detach();
+}
 
-        return;
+void Index::Impl::downloadItem(std::shared_ptr<Installation> installation, size_t index) {
+    auto item = installation->list.list.at(index);
+    auto id = item->getMetadata().getID();
+    auto partFile = getPartialDownloadPath(item);
+    log::debug("Installing {}", id);
+
+    installation->running += 1;
+
+    // A previous attempt may have gotten the whole file already
+    std::error_code ec;
+    if (!ghc::filesystem::exists(partFile, ec)) {
+        return this->fetchItem(installation, index);
     }
+    calculateHashAsync(partFile, [=, this](Result<std::string> const& hash) {
+        if (installation->failed) {
+            installation->running -= 1;
+            return;
+        }
+        // An unreadable file is just downloaded again
+        if (hash && hash.unwrap() == item->getPackageHash()) {
+            installation->running -= 1;
+            log::debug("Using previously downloaded {}", id);
+            return this->finishItem(installation, index);
+        }
+        this->fetchItem(installation, index);
+    });
+}
 
-    auto scaledProgress = [index, list](double progress) -> uint8_t {
-        return static_cast<uint8_t>(
-            progress * (static_cast<double>(index + 1) / list.list.size())
-        );
+void Index::Impl::fetchItem(std::shared_ptr<Installation> installation, size_t index) {
+    auto item = installation->list.list.at(index);
+    auto id = item->getMetadata().getID();
+    auto partFile = getPartialDownloadPath(item);
+
+    // The download is hashed as it arrives so the file doesn't have to be 
+    // read back afterwards
+    struct StreamedDownload {
+        IncrementalHash hash;
+        std::string head;
     };
+    auto streamed = std::make_shared<StreamedDownload>();
 
-    auto item = list.list.at(index);
-    auto tempFile = dirs::getTempDir() / (item->getMetadata().getID() + ".index");
-    log::debug("Installing {}", item->getMetadata().getID());
-    m_runningInstallations[list.target] = web::AsyncWebRequest()
-        .join("install_item_" + item->getMetadata().getID())
+    installation->requests[index] = web::AsyncWebRequest()
+        .join("install_item_" + id)
+        .resumable()
         .fetch(item->getDownloadURL())
-        .into(tempFile)
+        .into(partFile)
+        .chunk([streamed](void const* data, size_t size) {
+            // Keep the start of the body around to check for a 404 page
+            if (streamed->head.size() < 16) {
+                auto bytes = static_cast<char const*>(data);
+                streamed->head.append(bytes, std::min(size, 16 - streamed->head.size()));
+            }
+            streamed->hash.add(data, size);
+        })
         .then([=, this](auto) {
-            // Check for 404
-            auto notFound = utils::file::readString(tempFile);
-            if (notFound && notFound.unwrap() == "Not Found") {
-                return postError(fmt::format(
+            installation->running -= 1;
+            installation->requests[index] = nullptr;
+            if (installation->failed) return;
+
+            // If this download resumed a partial file or was joined to an 
+            // already running download of the same item, we didn't see all 
+            // of the data
+            std::error_code ec;
+            auto fileSize = ghc::filesystem::file_size(partFile, ec);
+            bool sawAll = !ec && fileSize == streamed->hash.size();
+
+            // Check for 404; anything longer than the head can't be one
+            auto body = sawAll ? streamed->head : (!ec && fileSize <= 16) ?
+                utils::file::readString(partFile).unwrapOr("") : "";
+            if (body == "Not Found") {
+                ghc::filesystem::remove(partFile, ec);
+                return this->failInstallation(installation, fmt::format(
                     "Binary file download for {} returned \"404 Not found\". "
                     "Report this to the Geode development team.",
-                    item->getMetadata().getID()
+                    id
                 ));
             }
 
             // Verify checksum
-            ModInstallEvent(
-                list.target->getMetadata().getID(),
-                UpdateProgress(
-                    scaledProgress(100),
-                    fmt::format("Verifying {}", item->getMetadata().getID())
-                )
-            ).post();
+            this->postInstallProgress(installation, fmt::format("Verifying {}", id));
 
-            if (::calculateHash(tempFile) != item->getPackageHash()) {
-                return postError(fmt::format(
-                    "Checksum mismatch with {}! (Downloaded file did not match what "
-                    "was expected. Try again, and if the download fails another time, "
-                    "report this to the Geode development team.)",
-                    item->getMetadata().getID()
-                ));
+            auto verify = [=, this](Result<std::string> const& hash) {
+                if (installation->failed) return;
+                if (!hash) {
+                    return this->failInstallation(installation, fmt::format(
+                        "Unable to verify {}: {}", id, hash.unwrapErr()
+                    ));
+                }
+                if (hash.unwrap() != item->getPackageHash()) {
+                    // Don't resume from a broken file next time
+                    std::error_code ec;
+                    ghc::filesystem::remove(partFile, ec);
+                    return this->failInstallation(installation, fmt::format(
+                        "Checksum mismatch with {}! (Downloaded file did not match what "
+                        "was expected. Try again, and if the download fails another time, "
+                        "report this to the Geode development team.)",
+                        id
+                    ));
+                }
+                this->finishItem(installation, index);
+            };
+            if (sawAll) {
+                verify(Ok(streamed->hash.finish()));
+            }
+            else {
+                calculateHashAsync(partFile, verify);
             }
-
-            item->setIsInstalled(true);
-
-            log::debug("Installed {}", item->getMetadata().getID());
-
-            // Install next item in queue
-            this->installNext(index + 1, list);
         })
-        .expect([postError, list, item](std::string const& err) {
-            postError(fmt::format(
-                "Unable to download {}: {}",
-                item->getMetadata().getID(), err
+        .expect([=, this](std::string const& err, int code) {
+            installation->running -= 1;
+            installation->requests[index] = nullptr;
+            // The partial file doesn't fit what the server has, so start 
+            // from scratch next time
+            if (code == 416) {
+                std::error_code ec;
+                ghc::filesystem::remove(partFile, ec);
+            }
+            this->failInstallation(installation, fmt::format(
+                "Unable to download {}: {}", id, err
             ));
         })
-        .progress([this, item, list, scaledProgress](auto&, double now, double total) {
-            ModInstallEvent(
-                list.target->getMetadata().getID(),
-                UpdateProgress(
-                    scaledProgress(now / total * 100.0),
-                    fmt::format("Downloading {}", item->getMetadata().getID())
-                )
-            ).post();
+        .progress([=, this](auto&, double now, double total) {
+            // prevent nan at the start
+            if (total != 0.0) {
+                installation->progress[index] = now / total;
+            }
+            this->postInstallProgress(installation, installation->running > 1 ?
+                fmt::format("Downloading {} mods", installation->running) :
+                fmt::format("Downloading {}", id)
+            );
         })
-        .cancelled([postError](auto&) {
-            postError("Download cancelled");
+        .cancelled([=, this](auto&) {
+            installation->running -= 1;
+            installation->requests[index] = nullptr;
+            this->failInstallation(installation, "Download cancelled");
         })
         .send();
 }
 
+void Index::Impl::finishItem(std::shared_ptr<Installation> installation, size_t index) {
+    auto finished = installation->list.list.at(index);
+    finished->setIsInstalled(true);
+    installation->progress[index] = 1.0;
+    installation->finished += 1;
+
+    log::debug("Installed {}", finished->getMetadata().getID());
+
+    if (installation->finished < installation->list.list.size()) {
+        return this->startDownloads(installation);
+    }
+
+    m_runningInstallations.erase(installation->list.target);
+
+    // Move all downloaded files. The list is ordered so that dependencies 
+    // come before the mods that depend on them
+    for (auto& item : installation->list.list) {
+        // If the mod is already installed, delete the old .geode file
+        if (auto mod = Loader::get()->getInstalledMod(item->getMetadata().getID())) {
+            auto res = mod->uninstall();
+            if (!res) {
+                return this->failInstallation(installation, fmt::format(
+                    "Unable to uninstall old version of {}: {}",
+                    item->getMetadata().getID(), res.unwrapErr()
+                ));
+            }
+        }
+
+        // Move the temp file
+        std::error_code ec;
+        ghc::filesystem::rename(
+            getPartialDownloadPath(item),
+            dirs::getModsDir() / (item->getMetadata().getID() + ".geode"), ec
+        );
+        if (ec) {
+            return this->failInstallation(installation, fmt::format(
+                "Unable to move downloaded file for {}: {}",
+                item->getMetadata().getID(), ec.message()
+            ));
+        }
+    }
+
+    auto const& eventModID = installation->list.target->getMetadata().getID();
+    Loader::get()->queueInMainThread([eventModID]() {
+        ModInstallEvent(eventModID, UpdateFinished()).post();
+    });
+}
+
+void Index::Impl::failInstallation(std::shared_ptr<Installation> installation, std::string const& error) {
+    // Only report the first error, not every download stopped because of it
+    if (installation->failed) return;
+    installation->failed = true;
+    m_runningInstallations.erase(installation->list.target);
+
+    // Stop the other downloads; what they got so far is kept and resumed 
+    // the next time the mod is installed
+    for (auto& request : installation->requests) {
+        if (request) {
+            request->cancel();
+        }
+    }
+
+    ModInstallEvent(installation->list.target->getMetadata().getID(), error).post();
+}
+
+void Index::Impl::postInstallProgress(std::shared_ptr<Installation> const& installation, std::string const& status) {
+    double progress = 0.0;
+    for (auto& itemProgress : installation->progress) {
+        progress += itemProgress;
+    }
+    ModInstallEvent(
+        installation->list.target->getMetadata().getID(),
+        UpdateProgress(
+            static_cast<uint8_t>(progress / installation->progress.size() * 100.0),
+            status
+        )
+    ).post();
+}
+
 void Index::cancelInstall(IndexItemHandle item) {
     Loader::get()->queueInMainThread([this, item]() {
         if (m_impl->m_runningInstallations.count(item)) {
-            m_impl->m_runningInstallations.at(item)->cancel();
-            m_impl->m_runningInstallations.erase(item);
+            m_impl->failInstallation(
+                m_impl->m_runningInstallations.at(item), "Download cancelled"
+            );
         }
     });
 }
@@ -879,7 +1788,7 @@ void Index::install(IndexInstallList const& list) {
         return;
     }
     Loader::get()->queueInMainThread([this, list]() {
-        m_impl->installNext(0, list);
+        m_impl->beginInstallation(list);
     });
 }
 
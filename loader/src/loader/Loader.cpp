@@ -1,7 +1,15 @@
 #include <utility>
 
+#include "FrameAttribution.hpp"
 #include "LoaderImpl.hpp"
 
+#ifdef GEODE_IS_WINDOWS
+#include <intrin.h>
+#define GEODE_RETURN_ADDRESS() _ReturnAddress()
+#else
+#define GEODE_RETURN_ADDRESS() __builtin_return_address(0)
+#endif
+
 using namespace geode::prelude;
 
 Loader::Loader() : m_impl(new Impl) {}
@@ -70,7 +78,20 @@ std::vector<LoadProblem> Loader::getProblems() const {
 }
 
 void Loader::queueInMainThread(ScheduledFunction func) {
-    return m_impl->queueInMainThread(std::move(func));
+    // the function is charged to whichever mod's binary called this
+    Mod* mod = nullptr;
+    if (FrameAttribution::get()->isEnabled()) {
+        mod = FrameAttribution::get()->modFromAddress(GEODE_RETURN_ADDRESS());
+    }
+    return m_impl->queueInMainThread(std::move(func), mod);
+}
+
+void Loader::setFrameTimeAttributionEnabled(bool enabled) {
+    return FrameAttribution::get()->setEnabled(enabled);
+}
+
+bool Loader::isFrameTimeAttributionEnabled() const {
+    return FrameAttribution::get()->isEnabled();
 }
 
 Mod* Loader::takeNextMod() {
@@ -1,9 +1,13 @@
 #include "LoaderImpl.hpp"
 #include <cocos2d.h>
 
+#include "HangWatchdog.hpp"
+#include "HookImpl.hpp"
 #include "ModImpl.hpp"
 #include "ModMetadataImpl.hpp"
+#include "SpritesheetDecoder.hpp"
 #include "LogImpl.hpp"
+#include "Tracer.hpp"
 #include "console.hpp"
 
 #include <Geode/loader/Dirs.hpp>
@@ -78,10 +82,35 @@ Result<> Loader::Impl::setup() {
         log::popNest();
     }
 
+    if (this->getLaunchFlag("trace-startup")) {
+        Tracer::get()->setEnabled(true);
+    }
+
+    // enabled before any hooks are created so they start out profiled
+    if (this->getLaunchFlag("enable-hook-profiler")) {
+        Hook::setProfilingEnabled(true);
+    }
+
+    // hang reports are opt-in, since the main thread also stops drawing 
+    // for plenty of harmless reasons, like the window being dragged
+    if (this->getLaunchFlag("enable-hang-reports")) {
+        HangWatchdog::get()->setThreshold(HangWatchdog::DEFAULT_THRESHOLD);
+    }
+    if (auto threshold = this->getLaunchArgument("hang-threshold")) {
+        auto res = numFromString<int64_t>(*threshold);
+        if (res) {
+            HangWatchdog::get()->setThreshold(std::chrono::milliseconds(res.unwrap()));
+        }
+        else {
+            log::warn("Invalid hang threshold \"{}\", expected milliseconds", *threshold);
+        }
+    }
+
     // on some platforms, using the crash handler overrides more convenient native handlers
     if (!this->getLaunchFlag("disable-crash-handler")) {
         log::debug("Setting up crash handler");
         log::pushNest();
+        TraceSpan span("Set up crash handler");
         if (!crashlog::setupPlatformHandler()) {
             log::debug("Failed to set up crash handler");
         }
@@ -92,15 +121,21 @@ Result<> Loader::Impl::setup() {
 
     log::debug("Loading hooks");
     log::pushNest();
-    if (!this->loadHooks()) {
-        return Err("There were errors loading some hooks, see console for details");
+    {
+        TraceSpan span("Load hooks");
+        if (!this->loadHooks()) {
+            return Err("There were errors loading some hooks, see console for details");
+        }
     }
     log::popNest();
 
     log::debug("Setting up directories");
     log::pushNest();
-    this->createDirectories();
-    this->addSearchPaths();
+    {
+        TraceSpan span("Set up directories");
+        this->createDirectories();
+        this->addSearchPaths();
+    }
     log::popNest();
 
     this->refreshModGraph();
@@ -210,12 +245,33 @@ Mod* Loader::Impl::getLoadedMod(std::string const& id) const {
     return nullptr;
 }
 
-void Loader::Impl::updateModResources(Mod* mod) {
+void Loader::Impl::queueResources(bool forceReload) {
+    log::debug("Queueing resources");
+    for (auto const& [_, mod] : m_mods) {
+        if (!forceReload && ModImpl::getImpl(mod)->m_resourcesLoaded)
+            continue;
+        this->addModSearchPath(mod);
+        SpritesheetDecoder::get()->queue(mod);
+        ModImpl::getImpl(mod)->m_resourcesLoaded = true;
+    }
+    SpritesheetDecoder::get()->setPackingEnabled(this->getLaunchFlag("pack-spritesheets"));
+    SpritesheetDecoder::get()->start();
+}
+
+bool Loader::Impl::uploadQueuedResources(std::chrono::nanoseconds budget) {
+    return SpritesheetDecoder::get()->uploadDecoded(budget);
+}
+
+void Loader::Impl::addModSearchPath(Mod* mod) {
     if (mod != Mod::get()) {
         // geode.loader resource is stored somewhere else, which is already added anyway
         auto searchPathRoot = dirs::getModRuntimeDir() / mod->getID() / "resources";
         CCFileUtils::get()->addSearchPath(searchPathRoot.string().c_str());
     }
+}
+
+void Loader::Impl::updateModResources(Mod* mod) {
+    this->addModSearchPath(mod);
 
     // only thing needs previous setup is spritesheets
     if (mod->getMetadata().getSpritesheets().empty())
@@ -223,6 +279,7 @@ void Loader::Impl::updateModResources(Mod* mod) {
 
     log::debug("{}", mod->getID());
     log::pushNest();
+    TraceSpan span("Mod resources", mod->getID());
 
     for (auto const& sheet : mod->getMetadata().getSpritesheets()) {
         log::debug("Adding sheet {}", sheet);
@@ -267,6 +324,7 @@ void Loader::Impl::queueMods(std::vector<ModMetadata>& modQueue) {
 
             log::debug("Found {}", entry.path().filename());
             log::pushNest();
+            TraceSpan span("Queue mod", entry.path().filename().string());
 
             auto res = ModMetadata::createFromGeodeFile(entry.path());
             if (!res) {
@@ -408,11 +466,13 @@ void Loader::Impl::loadModGraph(Mod* node, bool early) {
 
     auto unzipFunction = [this, node]() {
         log::debug("Unzip");
+        TraceSpan span("Unzip", node->getID());
         auto res = node->m_impl->unzipGeodeFile(node->getMetadata());
         return res;
     };
 
     auto loadFunction = [this, node, early]() {
+        TraceSpan span("Load mod", node->getID());
         if (node->shouldLoad()) {
             log::debug("Load");
             auto res = node->m_impl->loadBinary();
@@ -653,27 +713,39 @@ void Loader::Impl::refreshModGraph() {
     log::debug("Queueing mods");
     log::pushNest();
     std::vector<ModMetadata> modQueue;
-    this->queueMods(modQueue);
+    {
+        TraceSpan span("Queue mods");
+        this->queueMods(modQueue);
+    }
     log::popNest();
 
     m_loadingState = LoadingState::List;
     log::debug("Populating mod list");
     log::pushNest();
-    this->populateModList(modQueue);
-    modQueue.clear();
+    {
+        TraceSpan span("Populate mod list");
+        this->populateModList(modQueue);
+        modQueue.clear();
+    }
     log::popNest();
 
     m_loadingState = LoadingState::Graph;
     log::debug("Building mod graph");
     log::pushNest();
-    this->buildModGraph();
+    {
+        TraceSpan span("Build mod graph");
+        this->buildModGraph();
+    }
     log::popNest();
 
     m_loadingState = LoadingState::EarlyMods;
     log::debug("Loading early mods");
     log::pushNest();
-    for (auto const& dep : ModImpl::get()->m_dependants) {
-        this->loadModGraph(dep, true);
+    {
+        TraceSpan span("Load early mods");
+        for (auto const& dep : ModImpl::get()->m_dependants) {
+            this->loadModGraph(dep, true);
+        }
     }
     log::popNest();
 
@@ -728,7 +800,10 @@ void Loader::Impl::continueRefreshModGraph() {
         case LoadingState::Problems:
             log::debug("Finding problems");
             log::pushNest();
-            this->findProblems();
+            {
+                TraceSpan span("Find problems");
+                this->findProblems();
+            }
             log::popNest();
             m_loadingState = LoadingState::Done;
             {
@@ -775,23 +850,34 @@ void Loader::Impl::addUninitializedHook(Hook* hook, Mod* mod) {
     m_uninitializedHooks.emplace_back(hook, mod);
 }
 
+void Loader::Impl::removeUninitializedHooks(Mod* mod) {
+    std::erase_if(m_uninitializedHooks, [mod](auto const& pair) {
+        return pair.second == mod;
+    });
+}
+
 bool Loader::Impl::loadHooks() {
     m_readyToHook = true;
-    bool hadErrors = false;
+    return this->enableUninitializedHooks();
+}
+
+bool Loader::Impl::enableUninitializedHooks() {
+    std::vector<Hook::Impl*> hooks;
+    hooks.reserve(m_uninitializedHooks.size());
     for (auto const& [hook, mod] : m_uninitializedHooks) {
-        auto res = hook->enable();
-        if (!res) {
-            log::logImpl(Severity::Error, mod, "{}", res.unwrapErr());
-            hadErrors = true;
-        }
+        hooks.push_back(hook->m_impl.get());
     }
     m_uninitializedHooks.clear();
-    return !hadErrors;
+    return Hook::Impl::enableBatch(std::move(hooks)) == 0;
 }
 
-void Loader::Impl::queueInMainThread(const ScheduledFunction& func) {
+void Loader::Impl::updateHookProfiling() {
+    Hook::Impl::updateProfiling();
+}
+
+void Loader::Impl::queueInMainThread(const ScheduledFunction& func, Mod* mod) {
     std::lock_guard<std::mutex> lock(m_mainThreadMutex);
-    m_mainThreadQueue.push_back(func);
+    m_mainThreadQueue.emplace_back(func, mod);
 }
 
 void Loader::Impl::executeMainThreadQueue() {
@@ -803,8 +889,18 @@ void Loader::Impl::executeMainThreadQueue() {
     m_mainThreadMutex.unlock();
 
     // call queue
-    for (auto const& func : queue) {
-        func();
+    for (auto const& [func, mod] : queue) {
+        if (mod) {
+            // timed like a hook so the time is charged to the mod, and not
+            // also to the scheduler hook this runs in
+            HookProfile profile;
+            profile.owner = mod;
+            HookProfileScope scope(&profile);
+            func();
+        }
+        else {
+            func();
+        }
     }
 }
 
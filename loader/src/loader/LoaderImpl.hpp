@@ -43,7 +43,9 @@ namespace geode {
 
         LoadingState m_loadingState = LoadingState::None;
 
-        std::vector<utils::MiniFunction<void(void)>> m_mainThreadQueue;
+        // each function is paired with the mod that queued it, if frame time
+        // attribution was enabled at the time
+        std::vector<std::pair<ScheduledFunction, Mod*>> m_mainThreadQueue;
         mutable std::mutex m_mainThreadMutex;
         std::vector<std::pair<Hook*, Mod*>> m_uninitializedHooks;
         bool m_readyToHook = false;
@@ -77,12 +79,19 @@ namespace geode {
         Result<tulip::hook::HandlerHandle> getOrCreateHandler(void* address, tulip::hook::HandlerMetadata const& metadata);
 
         bool loadHooks();
+        /**
+         * Enable every hook that was claimed before the loader was ready to
+         * hook, or while its mod's binary was being loaded, in one batch
+         */
+        bool enableUninitializedHooks();
+        void updateHookProfiling();
 
         Impl();
         ~Impl();
 
         void createDirectories();
 
+        void addModSearchPath(Mod* mod);
         void updateModResources(Mod* mod);
         void addSearchPaths();
         void addNativeBinariesPath(ghc::filesystem::path const& path);
@@ -122,12 +131,20 @@ namespace geode {
         bool getLaunchFlag(std::string_view const name) const;
 
         void updateResources(bool forceReload);
-
-        void queueInMainThread(const ScheduledFunction& func);
+        /**
+         * Like updateResources, but decodes the spritesheets in the
+         * background. Call uploadQueuedResources every frame until it
+         * returns true to finish loading them
+         */
+        void queueResources(bool forceReload);
+        bool uploadQueuedResources(std::chrono::nanoseconds budget);
+
+        void queueInMainThread(const ScheduledFunction& func, Mod* mod = nullptr);
         void executeMainThreadQueue();
 
         bool isReadyToHook() const;
         void addUninitializedHook(Hook* hook, Mod* mod);
+        void removeUninitializedHooks(Mod* mod);
 
         Mod* getInternalMod();
         Result<> setupInternalMod();
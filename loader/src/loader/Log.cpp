@@ -102,19 +102,28 @@ void log::vlogImpl(Severity sev, Mod* mod, fmt::string_view format, fmt::format_
         nestCount += s_nestCountOffset;
     }
 
-    Logger::get()->push(sev, thread::getName(), mod->getName(), nestCount,
+    Logger::get()->push(sev, thread::getName(), mod->getNameRef(), nestCount,
         fmt::vformat(format, args));
 }
 
 
-Log::Log(Severity sev, std::string&& thread, std::string&& source, int32_t nestCount,
+Log::Log(Severity sev, std::string&& thread, std::string_view source, int32_t nestCount,
     std::string&& content) :
     m_time(log_clock::now()),
     m_severity(sev),
-    m_thread(thread),
+    m_thread(std::move(thread)),
     m_source(source),
     m_nestCount(nestCount),
-    m_content(content) {}
+    m_content(std::move(content)) {}
+
+Log::Log(Severity sev, std::string&& thread, std::string&& source, int32_t nestCount,
+    std::string&& content) :
+    m_time(log_clock::now()),
+    m_severity(sev),
+    m_thread(std::move(thread)),
+    m_ownedSource(std::move(source)),
+    m_nestCount(nestCount),
+    m_content(std::move(content)) {}
 
 Log::~Log() = default;
 
@@ -148,7 +157,11 @@ std::string Log::toString() const {
     }
 
     auto nestCount = m_nestCount;
-    auto source = m_source;
+    // the owned source isn't viewed by m_source since logs get moved around 
+    // in the history, which would leave a short string's view dangling
+    std::string_view source = m_source.empty() ? m_ownedSource : m_source;
+    // only filled in if the source has to be shortened
+    std::string collapsedSource;
     auto thread = m_thread;
 
     if (nestCount != 0) {
@@ -164,8 +177,10 @@ std::string Log::toString() const {
         if (initThreadLength == 0) {
             auto sourceCollapse = needsCollapse;
             auto sourceLength = std::max(initSourceLength - sourceCollapse, 2);
-            if (sourceLength < source.size())
-                source = fmt::format("{}>", source.substr(0, sourceLength - 1));
+            if (sourceLength < source.size()) {
+                collapsedSource = fmt::format("{}>", source.substr(0, sourceLength - 1));
+                source = collapsedSource;
+            }
         }
         else {
             auto sourceCollapse = needsCollapse / 2;
@@ -179,8 +194,10 @@ std::string Log::toString() const {
             sourceCollapse = needsCollapse - threadCollapse;
             sourceLength = std::max(initSourceLength - sourceCollapse, 2);
 
-            if (sourceLength < source.size())
-                source = fmt::format("{}>", source.substr(0, sourceLength - 1));
+            if (sourceLength < source.size()) {
+                collapsedSource = fmt::format("{}>", source.substr(0, sourceLength - 1));
+                source = collapsedSource;
+            }
             if (threadLength < thread.size())
                 thread = fmt::format("{}>", thread.substr(0, threadLength - 1));
         }
@@ -220,6 +237,17 @@ std::mutex& getLogMutex() {
     return mutex;
 }
 
+void Logger::push(Severity sev, std::string&& thread, std::string_view source, int32_t nestCount,
+    std::string&& content) {
+    Log* log;
+    {
+        std::lock_guard g(getLogMutex());
+        log = &m_logs.emplace_back(sev, std::move(thread), source, nestCount,
+            std::move(content));
+    }
+    this->write(log);
+}
+
 void Logger::push(Severity sev, std::string&& thread, std::string&& source, int32_t nestCount,
     std::string&& content) {
     Log* log;
@@ -228,6 +256,10 @@ void Logger::push(Severity sev, std::string&& thread, std::string&& source, int3
         log = &m_logs.emplace_back(sev, std::move(thread), std::move(source), nestCount,
             std::move(content));
     }
+    this->write(log);
+}
+
+void Logger::write(Log* log) {
     auto const logStr = log->toString();
     {
         std::lock_guard g(getLogMutex());
@@ -6,18 +6,24 @@
 #include <vector>
 #include <fstream>
 #include <string>
+#include <string_view>
 
 namespace geode::log {
     class Log final {
         log_clock::time_point m_time;
         Severity m_severity;
         std::string m_thread;
-        std::string m_source;
+        // the mod's interned name, see ModMetadata::getNameRef
+        std::string_view m_source;
+        // for sources that aren't mods, which only live as long as the log
+        std::string m_ownedSource;
         int32_t m_nestCount;
         std::string m_content;
 
     public:
         ~Log();
+        Log(Severity sev, std::string&& thread, std::string_view source, int32_t nestCount,
+            std::string&& content);
         Log(Severity sev, std::string&& thread, std::string&& source, int32_t nestCount,
             std::string&& content);
 
@@ -32,11 +38,22 @@ namespace geode::log {
         std::ofstream m_logStream;
 
         Logger() = default;
+
+        void write(Log* log);
     public:
         static Logger* get();
 
         void setup();
 
+        /**
+         * Push a log from a mod. The source must outlive the log, which 
+         * interned mod names do
+         */
+        void push(Severity sev, std::string&& thread, std::string_view source, int32_t nestCount,
+            std::string&& content);
+        /**
+         * Push a log whose source is kept with it
+         */
         void push(Severity sev, std::string&& thread, std::string&& source, int32_t nestCount,
             std::string&& content);
 
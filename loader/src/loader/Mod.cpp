@@ -5,6 +5,7 @@
 #include <Geode/loader/Index.hpp>
 #include <optional>
 #include <string_view>
+#include <utility>
 
 using namespace geode::prelude;
 
@@ -36,6 +37,26 @@ std::optional<std::string> Mod::getDetails() const {
     return m_impl->getDetails();
 }
 
+std::string const& Mod::getIDRef() const {
+    return m_impl->getMetadataRef().getIDRef();
+}
+
+std::string const& Mod::getNameRef() const {
+    return m_impl->getMetadataRef().getNameRef();
+}
+
+std::vector<std::string> const& Mod::getDevelopersRef() const {
+    return m_impl->getMetadataRef().getDevelopersRef();
+}
+
+std::optional<std::string> const& Mod::getDescriptionRef() const {
+    return m_impl->getMetadataRef().getDescriptionRef();
+}
+
+std::optional<std::string> const& Mod::getDetailsRef() const {
+    return m_impl->getMetadataRef().getDetailsRef();
+}
+
 ghc::filesystem::path Mod::getPackagePath() const {
     return m_impl->getPackagePath();
 }
@@ -48,6 +69,10 @@ matjson::Value& Mod::getSaveContainer() {
     return m_impl->getSaveContainer();
 }
 
+matjson::Value const& Mod::getSaveContainer() const {
+    return std::as_const(*m_impl).getSaveContainer();
+}
+
 bool Mod::isEnabled() const {
     return m_impl->isEnabled();
 }
@@ -64,6 +89,10 @@ ModMetadata Mod::getMetadata() const {
     return m_impl->getMetadata();
 }
 
+ModMetadata const& Mod::getMetadataRef() const {
+    return m_impl->getMetadataRef();
+}
+
 ghc::filesystem::path Mod::getTempDir() const {
     return m_impl->getTempDir();
 }
@@ -218,6 +247,10 @@ ModJson Mod::getRuntimeInfo() const {
     return m_impl->getRuntimeInfo();
 }
 
+std::vector<std::chrono::nanoseconds> Mod::getRecentFrameTimes() const {
+    return m_impl->getRecentFrameTimes();
+}
+
 bool Mod::isLoggingEnabled() const {
     return m_impl->isLoggingEnabled();
 }
@@ -227,7 +260,7 @@ void Mod::setLoggingEnabled(bool enabled) {
 }
 
 bool Mod::hasSavedValue(std::string_view const key) {
-    return this->getSaveContainer().contains(key);
+    return std::as_const(*m_impl).getSaveContainer().contains(key);
 }
 
 bool Mod::shouldLoad() const {
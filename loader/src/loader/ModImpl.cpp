@@ -1,10 +1,13 @@
 #include "ModImpl.hpp"
 #include "LoaderImpl.hpp"
 #include "ModMetadataImpl.hpp"
+#include "HangWatchdog.hpp"
 #include "HookImpl.hpp"
 #include "PatchImpl.hpp"
 #include "about.hpp"
 #include "console.hpp"
+#include "SaveWriter.hpp"
+#include "Tracer.hpp"
 
 #include <hash/hash.hpp>
 #include <Geode/loader/Dirs.hpp>
@@ -91,6 +94,10 @@ ModMetadata Mod::Impl::getMetadata() const {
     return m_metadata;
 }
 
+ModMetadata const& Mod::Impl::getMetadataRef() const {
+    return m_metadata;
+}
+
 #if defined(GEODE_EXPOSE_SECRET_INTERNALS_IN_HEADERS_DO_NOT_DEFINE_PLEASE)
 void Mod::Impl::setMetadata(ModMetadata const& metadata) {
     m_metadata = metadata;
@@ -120,6 +127,10 @@ matjson::Value& Mod::Impl::getSaveContainer() {
     return m_saved;
 }
 
+matjson::Value const& Mod::Impl::getSaveContainer() const {
+    return m_saved;
+}
+
 bool Mod::Impl::isEnabled() const {
     return m_enabled;
 }
@@ -176,6 +187,7 @@ Result<> Mod::Impl::loadData() {
         auto root = checker.root(fmt::format("[{}/settings.json]", this->getID()));
 
         m_savedSettingsData = json;
+        m_lastSettingsDump = settingData;
 
         for (auto& [key, value] : root.items()) {
             // check if this is a known setting
@@ -217,13 +229,15 @@ Result<> Mod::Impl::loadData() {
             log::warn("saved.json was somehow not an object, forcing it to one");
             m_saved = matjson::Object();
         }
+        m_lastSavedDump = m_saved.dump();
     }
 
     return Ok();
 }
 
 Result<> Mod::Impl::saveData() {
-    // saveData is expected to be synchronous, and always called from GD thread
+    // saveData is always called from GD thread. The values are serialized 
+    // here, but the files are written in the background by SaveWriter
     ModStateEvent(m_self, ModEventType::DataSaved).post();
 
     // Data saving should be fully fail-safe
@@ -253,17 +267,19 @@ Result<> Mod::Impl::saveData() {
         }
     }
 
-    std::string settingsStr = json.dump();
-    std::string savedStr = m_saved.dump();
-
-    auto res = utils::file::writeString(m_saveDirPath / "settings.json", settingsStr);
-    if (!res) {
-        log::error("Unable to save settings: {}", res.unwrapErr());
+    // comparing the serialized form catches every change, including ones 
+    // custom settings don't report and ones made through a saved reference 
+    // to the save container; only the disk writes are skipped
+    auto settingsStr = json.dump();
+    if (settingsStr != m_lastSettingsDump) {
+        m_lastSettingsDump = settingsStr;
+        SaveWriter::get()->queue(m_saveDirPath / "settings.json", std::move(settingsStr));
     }
 
-    auto res2 = utils::file::writeString(m_saveDirPath / "saved.json", savedStr);
-    if (!res2) {
-        log::error("Unable to save values: {}", res2.unwrapErr());
+    auto savedStr = m_saved.dump();
+    if (savedStr != m_lastSavedDump) {
+        m_lastSavedDump = savedStr;
+        SaveWriter::get()->queue(m_saveDirPath / "saved.json", std::move(savedStr));
     }
 
     return Ok();
@@ -382,10 +398,18 @@ Result<> Mod::Impl::loadBinary() {
 
     m_enabled = true;
     m_isCurrentlyLoading = true;
-    auto res = this->loadPlatformBinary();
+    m_isLoadingBinary = true;
+    auto res = [&] {
+        // also covers the mod's $execute blocks, since they run as static
+        // initializers while the binary is loaded
+        TraceSpan span("Load binary", m_metadata.getID());
+        return this->loadPlatformBinary();
+    }();
+    m_isLoadingBinary = false;
     if (!res) {
         m_isCurrentlyLoading = false;
         m_enabled = false;
+        LoaderImpl::get()->removeUninitializedHooks(m_self);
         // make sure to free up the next mod mutex
         LoaderImpl::get()->releaseNextMod();
         log::error("Failed to load binary for mod {}: {}", m_metadata.getID(), res.unwrapErr());
@@ -394,9 +418,18 @@ Result<> Mod::Impl::loadBinary() {
 
     LoaderImpl::get()->releaseNextMod();
 
+    if (LoaderImpl::get()->isReadyToHook()) {
+        TraceSpan span("Enable hooks", m_metadata.getID());
+        if (!LoaderImpl::get()->enableUninitializedHooks()) {
+            log::error("Failed to enable some hooks for mod {}", m_metadata.getID());
+        }
+    }
 
-    ModStateEvent(m_self, ModEventType::Loaded).post();
-    ModStateEvent(m_self, ModEventType::Enabled).post();
+    {
+        TraceSpan span("Loaded event", m_metadata.getID());
+        ModStateEvent(m_self, ModEventType::Loaded).post();
+        ModStateEvent(m_self, ModEventType::Enabled).post();
+    }
 
     m_isCurrentlyLoading = false;
 
@@ -517,7 +550,9 @@ Result<Hook*> Mod::Impl::claimHook(std::shared_ptr<Hook> hook) {
     if (!this->isEnabled() || !hook->getAutoEnable())
         return Ok(ptr);
 
-    if (!LoaderImpl::get()->isReadyToHook() && hook->getAutoEnable()) {
+    // hooks claimed while the mod's binary is loading are enabled together
+    // once it's done, see loadBinary
+    if (!LoaderImpl::get()->isReadyToHook() || m_isLoadingBinary) {
         LoaderImpl::get()->addUninitializedHook(ptr, m_self);
         return Ok(ptr);
     }
@@ -735,11 +770,43 @@ ModJson Mod::Impl::getRuntimeInfo() const {
     obj["temp-dir"] = this->getTempDir();
     obj["save-dir"] = this->getSaveDir();
     obj["config-dir"] = this->getConfigDir(false);
+    if (m_frameHistoryCount > 0) {
+        int64_t total = 0;
+        int64_t max = 0;
+        auto times = this->getRecentFrameTimes();
+        for (auto time : times) {
+            total += time.count();
+            max = std::max<int64_t>(max, time.count());
+        }
+        auto frameTime = matjson::Object();
+        frameTime["frames"] = static_cast<double>(times.size());
+        frameTime["average-ns"] = static_cast<double>(total / static_cast<int64_t>(times.size()));
+        frameTime["max-ns"] = static_cast<double>(max);
+        obj["frame-time"] = frameTime;
+    }
+    if (this->isInternal()) {
+        auto longFrames = matjson::Object();
+        auto histogram = HangWatchdog::get()->getLongFrameHistogram();
+        for (size_t i = 0; i < histogram.size(); i++) {
+            longFrames[fmt::format("{}ms", HangWatchdog::LONG_FRAME_BUCKETS_MS[i])] = static_cast<double>(histogram[i]);
+        }
+        obj["long-frames"] = longFrames;
+    }
     json["runtime"] = obj;
 
     return json;
 }
 
+std::vector<std::chrono::nanoseconds> Mod::Impl::getRecentFrameTimes() const {
+    auto count = std::min(m_frameHistoryCount, m_frameHistory.size());
+    std::vector<std::chrono::nanoseconds> times;
+    times.reserve(count);
+    for (size_t i = m_frameHistoryCount - count; i < m_frameHistoryCount; i++) {
+        times.emplace_back(m_frameHistory[i % m_frameHistory.size()]);
+    }
+    return times;
+}
+
 bool Mod::Impl::isLoggingEnabled() const {
     return m_loggingEnabled;
 }
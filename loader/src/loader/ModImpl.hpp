@@ -3,6 +3,9 @@
 #include <matjson.hpp>
 #include "ModPatch.hpp"
 #include <Geode/loader/Loader.hpp>
+#include <array>
+#include <atomic>
+#include <chrono>
 
 namespace geode {
     class Mod::Impl {
@@ -46,6 +49,13 @@ namespace geode {
          * Saved values
          */
         matjson::Value m_saved = matjson::Object();
+        /**
+         * Contents of saved.json as of the last load or save. Mods can keep 
+         * the reference from getSaveContainer around and change the values 
+         * whenever, so comparing against this is the only reliable way to 
+         * tell whether they changed
+         */
+        std::string m_lastSavedDump;
         /**
          * Setting values
          */
@@ -54,6 +64,11 @@ namespace geode {
          * Settings save data. Stored for efficient loading of custom settings
          */
         matjson::Value m_savedSettingsData = matjson::Object();
+        /**
+         * Contents of settings.json as of the last load or save, used to
+         * skip rewriting it if no setting has changed
+         */
+        std::string m_lastSettingsDump;
         /**
          * Whether the mod resources are loaded or not
          */
@@ -66,11 +81,31 @@ namespace geode {
         std::unordered_map<std::string, char const*> m_expandedSprites;
 
         bool m_isCurrentlyLoading = false;
+        /**
+         * Whether the mod's binary is being loaded right now. Hooks claimed
+         * during this are enabled in a single batch afterwards
+         */
+        bool m_isLoadingBinary = false;
 
         ModRequestedAction m_requestedAction = ModRequestedAction::None;
 
         std::vector<LoadProblem> m_problems;
 
+        static constexpr size_t FRAME_HISTORY_SIZE = 240;
+        /**
+         * Main thread time spent in this mod's code during the current frame,
+         * in nanoseconds. Only tracked while frame time attribution is enabled
+         */
+        std::atomic<int64_t> m_frameTimeNs = 0;
+        /**
+         * Ring buffer of the totals of the last FRAME_HISTORY_SIZE frames
+         */
+        std::array<int64_t, FRAME_HISTORY_SIZE> m_frameHistory {};
+        /**
+         * How many frames have been recorded into m_frameHistory in total
+         */
+        size_t m_frameHistoryCount = 0;
+
         Impl(Mod* self, ModMetadata const& metadata);
         ~Impl();
 
@@ -95,10 +130,12 @@ namespace geode {
         bool isInternal() const;
         bool needsEarlyLoad() const;
         ModMetadata getMetadata() const;
+        ModMetadata const& getMetadataRef() const;
         ghc::filesystem::path getTempDir() const;
         ghc::filesystem::path getBinaryPath() const;
 
         matjson::Value& getSaveContainer();
+        matjson::Value const& getSaveContainer() const;
 
 #if defined(GEODE_EXPOSE_SECRET_INTERNALS_IN_HEADERS_DO_NOT_DEFINE_PLEASE)
         void setMetadata(ModMetadata const& metadata);
@@ -149,6 +186,7 @@ namespace geode {
 
         char const* expandSpriteName(char const* name);
         ModJson getRuntimeInfo() const;
+        std::vector<std::chrono::nanoseconds> getRecentFrameTimes() const;
 
         bool isLoggingEnabled() const;
         void setLoggingEnabled(bool enabled);
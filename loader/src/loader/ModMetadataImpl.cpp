@@ -7,6 +7,8 @@
 #include <matjson.hpp>
 #include <utility>
 #include <clocale>
+#include <mutex>
+#include <unordered_set>
 
 #include "ModMetadataImpl.hpp"
 #include "LoaderImpl.hpp"
@@ -137,6 +139,7 @@ Result<ModMetadata> ModMetadata::Impl::createFromSchemaV010(ModJson const& rawJs
         // todo: make this use validateID in full 2.0.0 release
         .validate(MiniFunction<bool(std::string const&)>(&ModMetadata::Impl::validateOldID))
         .into(impl->m_id);
+    impl->m_internedID = &ModMetadata::internID(impl->m_id);
 
     // if (!isDeprecatedIDForm(impl->m_id)) {
     //     log::warn(
@@ -148,6 +151,7 @@ Result<ModMetadata> ModMetadata::Impl::createFromSchemaV010(ModJson const& rawJs
 
     root.needs("version").into(impl->m_version);
     root.needs("name").into(impl->m_name);
+    impl->m_internedName = &Impl::internName(impl->m_name);
     if (root.has("developers")) {
         if (root.has("developer")) {
             return Err("[mod.json] can not have both \"developer\" and \"developers\" specified");
@@ -412,7 +416,7 @@ ModJson ModMetadata::Impl::getRawJSON() const {
 }
 
 bool ModMetadata::Impl::operator==(ModMetadata::Impl const& other) const {
-    return this->m_id == other.m_id;
+    return this->m_internedID == other.m_internedID;
 }
 
 [[maybe_unused]] ghc::filesystem::path ModMetadata::getPath() const {
@@ -431,6 +435,30 @@ std::string ModMetadata::getID() const {
     return m_impl->m_id;
 }
 
+std::string const& ModMetadata::getIDRef() const {
+    return *m_impl->m_internedID;
+}
+
+std::string const& ModMetadata::internID(std::string_view id) {
+    // mod IDs are few and never released, so the table just grows; 
+    // std::unordered_set never moves its elements, which keeps the 
+    // returned references stable
+    static std::mutex mutex;
+    static std::unordered_set<std::string> ids;
+    std::lock_guard lock(mutex);
+    return *ids.emplace(id).first;
+}
+
+std::string const& ModMetadata::Impl::internName(std::string_view name) {
+    // kept apart from the IDs, so a name can never compare equal to an ID 
+    // by address. Logs refer to these for the rest of the game's lifetime, 
+    // so they're never released either
+    static std::mutex mutex;
+    static std::unordered_set<std::string> names;
+    std::lock_guard lock(mutex);
+    return *names.emplace(name).first;
+}
+
 bool ModMetadata::usesDeprecatedIDForm() const {
     return Impl::isDeprecatedIDForm(m_impl->m_id);
 }
@@ -439,6 +467,10 @@ std::string ModMetadata::getName() const {
     return m_impl->m_name;
 }
 
+std::string const& ModMetadata::getNameRef() const {
+    return *m_impl->m_internedName;
+}
+
 std::string ModMetadata::getDeveloper() const {
     // m_developers should be guaranteed to never be empty, but this is 
     // just in case it is anyway somehow
@@ -461,26 +493,50 @@ std::vector<std::string> ModMetadata::getDevelopers() const {
     return m_impl->m_developers;
 }
 
+std::vector<std::string> const& ModMetadata::getDevelopersRef() const {
+    return m_impl->m_developers;
+}
+
 std::optional<std::string> ModMetadata::getDescription() const {
     return m_impl->m_description;
 }
 
+std::optional<std::string> const& ModMetadata::getDescriptionRef() const {
+    return m_impl->m_description;
+}
+
 std::optional<std::string> ModMetadata::getDetails() const {
     return m_impl->m_details;
 }
 
+std::optional<std::string> const& ModMetadata::getDetailsRef() const {
+    return m_impl->m_details;
+}
+
 std::optional<std::string> ModMetadata::getChangelog() const {
     return m_impl->m_changelog;
 }
 
+std::optional<std::string> const& ModMetadata::getChangelogRef() const {
+    return m_impl->m_changelog;
+}
+
 std::optional<std::string> ModMetadata::getSupportInfo() const {
     return m_impl->m_supportInfo;
 }
 
+std::optional<std::string> const& ModMetadata::getSupportInfoRef() const {
+    return m_impl->m_supportInfo;
+}
+
 std::optional<std::string> ModMetadata::getRepository() const {
     return m_impl->m_repository;
 }
 
+std::optional<std::string> const& ModMetadata::getRepositoryRef() const {
+    return m_impl->m_repository;
+}
+
 std::optional<ModMetadata::IssuesInfo> ModMetadata::getIssues() const {
     return m_impl->m_issues;
 }
@@ -489,18 +545,34 @@ std::vector<ModMetadata::Dependency> ModMetadata::getDependencies() const {
     return m_impl->m_dependencies;
 }
 
+std::vector<ModMetadata::Dependency> const& ModMetadata::getDependenciesRef() const {
+    return m_impl->m_dependencies;
+}
+
 std::vector<ModMetadata::Incompatibility> ModMetadata::getIncompatibilities() const {
     return m_impl->m_incompatibilities;
 }
 
+std::vector<ModMetadata::Incompatibility> const& ModMetadata::getIncompatibilitiesRef() const {
+    return m_impl->m_incompatibilities;
+}
+
 std::vector<std::string> ModMetadata::getSpritesheets() const {
     return m_impl->m_spritesheets;
 }
 
+std::vector<std::string> const& ModMetadata::getSpritesheetsRef() const {
+    return m_impl->m_spritesheets;
+}
+
 std::vector<std::pair<std::string, Setting>> ModMetadata::getSettings() const {
     return m_impl->m_settings;
 }
 
+std::vector<std::pair<std::string, Setting>> const& ModMetadata::getSettingsRef() const {
+    return m_impl->m_settings;
+}
+
 bool ModMetadata::needsEarlyLoad() const {
     return m_impl->m_needsEarlyLoad;
 }
@@ -552,10 +624,12 @@ void ModMetadata::setVersion(VersionInfo const& value) {
 
 void ModMetadata::setID(std::string const& value) {
     m_impl->m_id = value;
+    m_impl->m_internedID = &ModMetadata::internID(value);
 }
 
 void ModMetadata::setName(std::string const& value) {
     m_impl->m_name = value;
+    m_impl->m_internedName = &Impl::internName(value);
 }
 
 void ModMetadata::setDeveloper(std::string const& value) {
@@ -663,7 +737,10 @@ std::vector<std::pair<std::string, std::optional<std::string>*>> ModMetadata::ge
 }
 
 ModMetadata::ModMetadata() : m_impl(std::make_unique<Impl>()) {}
-ModMetadata::ModMetadata(std::string id) : m_impl(std::make_unique<Impl>()) { m_impl->m_id = std::move(id); }
+ModMetadata::ModMetadata(std::string id) : m_impl(std::make_unique<Impl>()) {
+    m_impl->m_internedID = &ModMetadata::internID(id);
+    m_impl->m_id = std::move(id);
+}
 ModMetadata::ModMetadata(ModMetadata const& other) : m_impl(std::make_unique<Impl>(*other.m_impl)) {}
 ModMetadata::ModMetadata(ModMetadata&& other) noexcept : m_impl(std::move(other.m_impl)) {}
 
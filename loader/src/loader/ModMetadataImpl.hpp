@@ -14,7 +14,12 @@ namespace geode {
         std::string m_binaryName;
         VersionInfo m_version{1, 0, 0};
         std::string m_id;
+        // interned copy of m_id, kept in sync by everything that sets the ID
+        std::string const* m_internedID = &ModMetadata::internID("");
         std::string m_name;
+        // interned copy of m_name, so the log can keep referring to it after 
+        // the mod is gone
+        std::string const* m_internedName = &Impl::internName("");
         std::vector<std::string> m_developers;
         std::string m_gdVersion;
         VersionInfo m_geodeVersion;
@@ -46,6 +51,7 @@ namespace geode {
         static bool validateID(std::string const& id);
         static bool validateOldID(std::string const& id);
         static bool isDeprecatedIDForm(std::string const& id);
+        static std::string const& internName(std::string_view name);
 
         static Result<ModMetadata> createFromSchemaV010(ModJson const& rawJson);
 
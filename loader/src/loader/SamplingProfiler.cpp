@@ -0,0 +1,341 @@
+#include "SamplingProfiler.hpp"
+
+#include "FrameAttribution.hpp"
+
+#include <Geode/loader/Dirs.hpp>
+#include <Geode/utils/file.hpp>
+#include <Geode/utils/general.hpp>
+#include <algorithm>
+#include <chrono>
+#include <cstring>
+#include <fmt/format.h>
+
+#ifdef GEODE_IS_ANDROID
+#include <cerrno>
+#include <csignal>
+#include <ctime>
+#include <sys/syscall.h>
+#include <sys/uio.h>
+#include <ucontext.h>
+#include <unistd.h>
+#endif
+
+SamplingProfiler* SamplingProfiler::get() {
+    static auto inst = new SamplingProfiler();
+    return inst;
+}
+
+size_t SamplingProfiler::StackHash::operator()(std::vector<uintptr_t> const& stack) const {
+    size_t hash = stack.size();
+    for (auto frame : stack) {
+        hash ^= std::hash<uintptr_t>()(frame) + 0x9e3779b9 + (hash << 6) + (hash >> 2);
+    }
+    return hash;
+}
+
+#ifdef GEODE_IS_ANDROID
+
+// frame records further than this above the stack pointer are assumed to
+// be garbage rather than followed
+static constexpr uintptr_t MAX_STACK_SPAN = 8 * 1024 * 1024;
+
+// Code built without frame pointers uses the register for other things, so 
+// the chain can point anywhere, including past the end of the stack into 
+// unmapped memory. Reading through process_vm_readv makes the kernel check 
+// the address instead of faulting, and it's just a syscall, so it's still 
+// fine to do in a signal handler
+static bool readFrameRecord(uintptr_t fp, uintptr_t (&record)[2]) {
+    iovec local = { record, sizeof(record) };
+    iovec remote = { reinterpret_cast<void*>(fp), sizeof(record) };
+    return syscall(SYS_process_vm_readv, getpid(), &local, 1, &remote, 1, 0) ==
+        static_cast<long>(sizeof(record));
+}
+
+// Walks the frame pointer chain of the interrupted code. Unlike
+// _Unwind_Backtrace, this doesn't take any locks or allocate, so it's safe
+// to do in a signal handler. Frames without a frame record (like leaf
+// functions) don't show up as callers
+uint32_t SamplingProfiler::unwindContext(void const* ucontext, uintptr_t* frames, uint32_t maxFrames) {
+    auto context = static_cast<ucontext_t const*>(ucontext);
+    if (maxFrames < 2) {
+        return 0;
+    }
+#if defined(__aarch64__)
+    uintptr_t pc = context->uc_mcontext.pc;
+    uintptr_t sp = context->uc_mcontext.sp;
+    uintptr_t fp = context->uc_mcontext.regs[29];
+#elif defined(__x86_64__)
+    uintptr_t pc = context->uc_mcontext.gregs[REG_RIP];
+    uintptr_t sp = context->uc_mcontext.gregs[REG_RSP];
+    uintptr_t fp = context->uc_mcontext.gregs[REG_RBP];
+#elif defined(__i386__)
+    uintptr_t pc = context->uc_mcontext.gregs[REG_EIP];
+    uintptr_t sp = context->uc_mcontext.gregs[REG_ESP];
+    uintptr_t fp = context->uc_mcontext.gregs[REG_EBP];
+#else
+    // thumb code doesn't keep a usable frame pointer chain, so only the
+    // current function and its caller are known
+    frames[0] = context->uc_mcontext.arm_pc;
+    frames[1] = context->uc_mcontext.arm_lr;
+    return 2;
+#endif
+
+#if defined(__aarch64__) || defined(__x86_64__) || defined(__i386__)
+    uint32_t depth = 0;
+    frames[depth++] = pc;
+    while (
+        depth < maxFrames &&
+        fp >= sp && fp - sp < MAX_STACK_SPAN && fp % sizeof(uintptr_t) == 0
+    ) {
+        uintptr_t record[2];
+        if (!readFrameRecord(fp, record)) {
+            break;
+        }
+        auto next = record[0];
+        auto ret = record[1];
+        if (ret == 0) {
+            break;
+        }
+        // point into the call instruction rather than after it, so the
+        // address symbolizes to the right function
+        frames[depth++] = ret - 1;
+        if (next <= fp) {
+            break;
+        }
+        fp = next;
+    }
+    return depth;
+#endif
+}
+
+void SamplingProfiler::recordSample(void const* context) {
+    auto index = m_writeIndex.fetch_add(1, std::memory_order_relaxed);
+    auto& slot = m_slots[index % RING_SIZE];
+    slot.sequence.store(index * 2 + 1, std::memory_order_relaxed);
+    std::atomic_thread_fence(std::memory_order_release);
+    slot.mainThread = syscall(SYS_gettid) == m_mainThreadID;
+    slot.depth = unwindContext(context, slot.frames, MAX_FRAMES);
+    slot.sequence.store((index + 1) * 2, std::memory_order_release);
+}
+
+static void handleProfilingSignal(int, siginfo_t*, void* context) {
+    auto savedErrno = errno;
+    // the handler stays installed after stopping, since SIGPROF's default
+    // action would kill the game if a signal was still pending
+    if (SamplingProfiler::get()->isRunning()) {
+        SamplingProfiler::get()->recordSample(context);
+    }
+    errno = savedErrno;
+}
+
+Result<> SamplingProfiler::start(uint32_t frequency) {
+    if (this->isRunning()) {
+        return Ok();
+    }
+    if (frequency == 0 || frequency > 10000) {
+        return Err("Invalid sampling frequency {}", frequency);
+    }
+
+    if (!m_slots) {
+        m_slots = std::make_unique<Slot[]>(RING_SIZE);
+
+        struct sigaction action = {};
+        action.sa_sigaction = &handleProfilingSignal;
+        action.sa_flags = SA_SIGINFO | SA_RESTART;
+        sigemptyset(&action.sa_mask);
+        if (sigaction(SIGPROF, &action, nullptr) != 0) {
+            m_slots = nullptr;
+            return Err("Unable to install SIGPROF handler: {}", std::strerror(errno));
+        }
+    }
+
+    sigevent event = {};
+    event.sigev_notify = SIGEV_SIGNAL;
+    event.sigev_signo = SIGPROF;
+    timer_t timer;
+    // the kernel checks process CPU timers on the thread that's using the
+    // CPU, so that's also usually the thread the signal is delivered to
+    if (timer_create(CLOCK_PROCESS_CPUTIME_ID, &event, &timer) != 0) {
+        return Err("Unable to create profiling timer: {}", std::strerror(errno));
+    }
+
+    m_mainThreadID = static_cast<int>(syscall(SYS_gettid));
+    m_readIndex = m_writeIndex.load(std::memory_order_relaxed);
+    m_running.store(true, std::memory_order_relaxed);
+
+    itimerspec spec = {};
+    spec.it_interval.tv_nsec = 1'000'000'000 / frequency;
+    spec.it_value = spec.it_interval;
+    if (timer_settime(timer, 0, &spec, nullptr) != 0) {
+        auto err = errno;
+        m_running.store(false, std::memory_order_relaxed);
+        timer_delete(timer);
+        return Err("Unable to start profiling timer: {}", std::strerror(err));
+    }
+    m_timer = timer;
+
+    m_drainThread = std::thread([this]() {
+        thread::setName("Sampling Profiler");
+        while (this->isRunning()) {
+            this->drain();
+            std::this_thread::sleep_for(std::chrono::milliseconds(50));
+        }
+    });
+
+    log::info("Started sampling profiler at {}Hz", frequency);
+    return Ok();
+}
+
+void SamplingProfiler::stop() {
+    if (!this->isRunning()) {
+        return;
+    }
+    timer_delete(static_cast<timer_t>(m_timer));
+    m_timer = nullptr;
+    m_running.store(false, std::memory_order_relaxed);
+    m_drainThread.join();
+    this->drain();
+    log::info("Stopped sampling profiler");
+}
+
+#else
+
+uint32_t SamplingProfiler::unwindContext(void const* ucontext, uintptr_t* frames, uint32_t maxFrames) {
+    return 0;
+}
+
+void SamplingProfiler::recordSample(void const* context) {}
+
+Result<> SamplingProfiler::start(uint32_t frequency) {
+    return Err("The sampling profiler is only supported on Android");
+}
+
+void SamplingProfiler::stop() {}
+
+#endif
+
+void SamplingProfiler::drain() {
+    if (!m_slots) {
+        return;
+    }
+    auto writeIndex = m_writeIndex.load(std::memory_order_acquire);
+
+    std::lock_guard lock(m_stacksMutex);
+    // samples the writers have already lapped are lost
+    if (writeIndex - m_readIndex > RING_SIZE) {
+        m_droppedCount += writeIndex - m_readIndex - RING_SIZE;
+        m_readIndex = writeIndex - RING_SIZE;
+    }
+
+    std::vector<uintptr_t> stack;
+    for (; m_readIndex < writeIndex; m_readIndex++) {
+        auto& slot = m_slots[m_readIndex % RING_SIZE];
+        auto expected = (m_readIndex + 1) * 2;
+        auto sequence = slot.sequence.load(std::memory_order_acquire);
+        if (sequence < expected) {
+            // still being written, so pick it up next time
+            break;
+        }
+        if (sequence != expected) {
+            m_droppedCount += 1;
+            continue;
+        }
+        auto depth = std::min<uint32_t>(slot.depth, MAX_FRAMES);
+        stack.assign(1, slot.mainThread ? 1 : 0);
+        stack.insert(stack.end(), slot.frames, slot.frames + depth);
+        // make sure a writer didn't lap us while copying
+        std::atomic_thread_fence(std::memory_order_acquire);
+        if (slot.sequence.load(std::memory_order_relaxed) != expected) {
+            m_droppedCount += 1;
+            continue;
+        }
+
+        m_sampleCount += 1;
+        if (m_stacks.size() >= MAX_STACKS && !m_stacks.contains(stack)) {
+            stack.resize(std::min<size_t>(stack.size(), 2));
+            if (m_stacks.size() >= MAX_STACKS + MAX_OVERFLOW_STACKS && !m_stacks.contains(stack)) {
+                stack.resize(1);
+            }
+        }
+        m_stacks[stack] += 1;
+    }
+}
+
+void SamplingProfiler::reset() {
+    this->drain();
+    std::lock_guard lock(m_stacksMutex);
+    m_stacks.clear();
+    m_sampleCount = 0;
+    m_droppedCount = 0;
+}
+
+static std::string describeFrame(uintptr_t address, Mod*& mod) {
+    auto ptr = reinterpret_cast<void const*>(address);
+    mod = FrameAttribution::get()->modFromAddress(ptr);
+    auto name = FrameAttribution::get()->describeAddress(ptr);
+    // semicolons separate frames in the folded format
+    std::replace(name.begin(), name.end(), ';', ':');
+    return name;
+}
+
+Result<ghc::filesystem::path> SamplingProfiler::write() {
+    this->drain();
+
+    std::unordered_map<uintptr_t, std::pair<std::string, Mod*>> frames;
+    std::unordered_map<Mod*, uint64_t> modSamples;
+    // different addresses in the same functions give the same line
+    std::unordered_map<std::string, uint64_t> lines;
+    uint64_t sampleCount;
+    uint64_t droppedCount;
+    {
+        std::lock_guard lock(m_stacksMutex);
+        sampleCount = m_sampleCount;
+        droppedCount = m_droppedCount;
+        for (auto const& [stack, count] : m_stacks) {
+            // folded stacks go from the outermost frame in
+            std::string line = stack[0] ? "[main thread]" : "[other threads]";
+            if (stack.size() == 1) {
+                line += ";[too many stacks]";
+            }
+            for (size_t i = stack.size() - 1; i > 0; i--) {
+                auto it = frames.find(stack[i]);
+                if (it == frames.end()) {
+                    Mod* mod;
+                    auto name = describeFrame(stack[i], mod);
+                    it = frames.insert({ stack[i], { std::move(name), mod } }).first;
+                }
+                line += ';';
+                line += it->second.first;
+            }
+            lines[line] += count;
+
+            // samples count towards the mod whose code was running
+            if (stack.size() > 1) {
+                modSamples[frames[stack[1]].second] += count;
+            }
+        }
+    }
+
+    std::string output;
+    for (auto const& [line, count] : lines) {
+        output += fmt::format("{} {}\n", line, count);
+    }
+    auto path = dirs::getGeodeLogDir() / "sampling-profile.folded";
+    GEODE_UNWRAP(file::writeString(path, output));
+
+    std::vector<std::pair<Mod*, uint64_t>> sorted(modSamples.begin(), modSamples.end());
+    std::sort(sorted.begin(), sorted.end(), [](auto const& a, auto const& b) {
+        return a.second > b.second;
+    });
+    log::info("Sampling profile: {} samples ({} dropped)", sampleCount, droppedCount);
+    log::pushNest();
+    for (auto const& [mod, count] : sorted) {
+        log::info(
+            "{}: {} samples ({:.1f}%)",
+            mod ? mod->getID() : "<not a mod>", count, count * 100.0 / std::max<uint64_t>(sampleCount, 1)
+        );
+    }
+    log::popNest();
+
+    return Ok(path);
+}
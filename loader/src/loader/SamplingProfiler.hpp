@@ -0,0 +1,107 @@
+#pragma once
+
+#include <Geode/loader/Mod.hpp>
+#include <atomic>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+
+using namespace geode::prelude;
+
+/**
+ * Statistical CPU profiler for finding out which mods are using up CPU time
+ * without attaching external tools. While running, a process CPU timer
+ * raises SIGPROF at a fixed frequency, and the signal handler records the
+ * interrupted thread's stack into a fixed size ring buffer. A background
+ * thread drains the ring and counts identical stacks, up to a limit, so
+ * memory use stays bounded no matter how long it runs. Symbols and owning
+ * mods are only resolved when writing the results, as folded stacks that
+ * flame graph tools can read.
+ *
+ * Only supported on Android
+ */
+class SamplingProfiler final {
+public:
+    static constexpr size_t MAX_FRAMES = 32;
+    static constexpr size_t RING_SIZE = 4096;
+    // past this many distinct stacks, new ones are only counted by their
+    // innermost frame
+    static constexpr size_t MAX_STACKS = 16384;
+    // past this many more, new ones all go into a single bucket per thread 
+    // kind, which keeps memory use fixed
+    static constexpr size_t MAX_OVERFLOW_STACKS = 4096;
+
+protected:
+    struct Slot {
+        // odd while a sample is being written, 2 * (index + 1) once it's done
+        std::atomic<uint64_t> sequence = 0;
+        uint32_t depth;
+        bool mainThread;
+        uintptr_t frames[MAX_FRAMES];
+    };
+    struct StackHash {
+        size_t operator()(std::vector<uintptr_t> const& stack) const;
+    };
+
+    // allocated on first start and never freed, since a late signal may
+    // still write into it after stopping
+    std::unique_ptr<Slot[]> m_slots;
+    std::atomic<uint64_t> m_writeIndex = 0;
+    uint64_t m_readIndex = 0;
+    std::atomic<bool> m_running = false;
+    int m_mainThreadID = 0;
+    void* m_timer = nullptr;
+    std::thread m_drainThread;
+
+    std::mutex m_stacksMutex;
+    // the first element of each stack is 1 for the main thread, 0 otherwise;
+    // the rest are return addresses, innermost first
+    std::unordered_map<std::vector<uintptr_t>, uint64_t, StackHash> m_stacks;
+    uint64_t m_sampleCount = 0;
+    uint64_t m_droppedCount = 0;
+
+    void drain();
+
+public:
+    static SamplingProfiler* get();
+
+    /**
+     * Record the stack of the code a signal interrupted. Called from the
+     * SIGPROF handler, so this must stay async-signal-safe
+     * @param context The ucontext_t passed to the handler
+     */
+    void recordSample(void const* context);
+    /**
+     * Get the stack of the code a signal interrupted from the ucontext_t
+     * passed to its handler, innermost frame first. Async-signal-safe, and 
+     * safe to call on code without frame pointers, since every frame record 
+     * is read in a way that can't fault
+     * @returns The number of frames written
+     */
+    static uint32_t unwindContext(void const* context, uintptr_t* frames, uint32_t maxFrames);
+
+    /**
+     * Start sampling. Must be called from the main thread
+     * @param frequency Samples per second of CPU time
+     */
+    Result<> start(uint32_t frequency);
+    void stop();
+    bool isRunning() const {
+        return m_running.load(std::memory_order_relaxed);
+    }
+    /**
+     * Clear everything sampled so far
+     */
+    void reset();
+
+    /**
+     * Write everything sampled so far as folded stacks to
+     * sampling-profile.folded in the logs directory, and log which mods the
+     * samples landed in
+     * @returns The path of the written file
+     */
+    Result<ghc::filesystem::path> write();
+};
@@ -8,9 +8,28 @@
 #include <Geode/utils/general.hpp>
 #include <Geode/utils/JsonValidation.hpp>
 #include <re2/re2.h>
+#include <mutex>
+#include <unordered_map>
 
 using namespace geode::prelude;
 
+// Compiled regexes for StringSetting::match, shared by every setting with
+// the same pattern so each one is only compiled once
+static std::shared_ptr<re2::RE2 const> getCompiledPattern(std::string const& pattern) {
+    static std::mutex mutex;
+    static auto cache = new std::unordered_map<std::string, std::shared_ptr<re2::RE2 const>>();
+
+    std::lock_guard lock(mutex);
+    auto& compiled = (*cache)[pattern];
+    if (!compiled) {
+        // errors are reported when the setting is parsed instead
+        re2::RE2::Options options;
+        options.set_log_errors(false);
+        compiled = std::make_shared<re2::RE2 const>(pattern, options);
+    }
+    return compiled;
+}
+
 template<class T>
 static void parseCommon(T& sett, JsonMaybeObject& obj) {
     obj.has("name").into(sett.name);
@@ -77,6 +96,15 @@ Result<StringSetting> StringSetting::parse(JsonMaybeObject& obj) {
     parseCommon(sett, obj);
     obj.has("match").into(sett.match);
     obj.has("filter").into(sett.filter);
+    if (sett.match) {
+        sett.compiledMatch = getCompiledPattern(sett.match.value());
+        if (!sett.compiledMatch->ok()) {
+            return Err(
+                "Invalid regex \"{}\" in \"match\": {}",
+                sett.match.value(), sett.compiledMatch->error()
+            );
+        }
+    }
     return Ok(sett);
 }
 
@@ -364,7 +392,12 @@ IMPL_TO_VALID(Float) {
 
 IMPL_TO_VALID(String) {
     if (m_definition.match) {
-        if (!re2::RE2::FullMatch(value, m_definition.match.value())) {
+        // definitions built in code rather than parsed don't have the
+        // pattern compiled yet
+        auto compiled = m_definition.compiledMatch ?
+            m_definition.compiledMatch :
+            getCompiledPattern(m_definition.match.value());
+        if (!re2::RE2::FullMatch(value, *compiled)) {
             return {
                 m_definition.defaultValue,
                 fmt::format(
@@ -419,7 +452,7 @@ SettingChangedEvent::SettingChangedEvent(Mod* mod, SettingValue* value)
 ListenerResult SettingChangedFilter::handle(
     utils::MiniFunction<Callback> fn, SettingChangedEvent* event
 ) {
-    if (m_modID == event->mod->getID() &&
+    if (m_internedModID == &event->mod->getIDRef() &&
         (!m_targetKey || m_targetKey.value() == event->value->getKey())
     ) {
         fn(event->value);
@@ -430,4 +463,6 @@ ListenerResult SettingChangedFilter::handle(
 SettingChangedFilter::SettingChangedFilter(
     std::string const& modID,
     std::optional<std::string> const& settingKey
-) : m_modID(modID), m_targetKey(settingKey) {}
+) : m_modID(modID),
+    m_targetKey(settingKey),
+    m_internedModID(&ModMetadata::internID(modID)) {}
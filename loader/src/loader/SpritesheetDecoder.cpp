@@ -0,0 +1,464 @@
+#include "SpritesheetDecoder.hpp"
+#include "RectPacker.hpp"
+#include "Tracer.hpp"
+
+#include <Geode/loader/Log.hpp>
+#include <Geode/utils/casts.hpp>
+#include <Geode/utils/general.hpp>
+#include <algorithm>
+#include <cmath>
+#include <cstdlib>
+#include <cstring>
+#include <fmt/format.h>
+#include <thread>
+
+namespace {
+    // CCImage has no way to create a blank image without copying a buffer,
+    // so this fills in its fields directly
+    class AtlasImage : public CCImage {
+    public:
+        static AtlasImage* create(uint16_t width, uint16_t height, bool premultiplied) {
+            auto image = new AtlasImage();
+            image->m_nWidth = width;
+            image->m_nHeight = height;
+            image->m_nBitsPerComponent = 8;
+            image->m_bHasAlpha = true;
+            image->m_bPreMulti = premultiplied;
+            // CCImage frees this with delete[]
+            image->m_pData = new unsigned char[static_cast<size_t>(width) * height * 4]();
+            return image;
+        }
+    };
+
+    // sheets are small if they're at most this many pixels
+    constexpr uint32_t MAX_PACKED_SHEET_AREA = 512 * 512;
+    constexpr uint32_t ATLAS_SIZE = 2048;
+    // space around each packed region, filled by extending its edges so
+    // linear filtering doesn't pick up its neighbours
+    constexpr uint32_t ATLAS_PADDING = 2;
+}
+
+SpritesheetDecoder* SpritesheetDecoder::get() {
+    static auto inst = new SpritesheetDecoder();
+    return inst;
+}
+
+void SpritesheetDecoder::queue(Mod* mod) {
+    if (!m_batch) {
+        m_batch = std::make_shared<Batch>();
+        m_uploadedCount = 0;
+        m_packed = false;
+    }
+    auto ccfu = CCFileUtils::get();
+    for (auto const& name : mod->getMetadata().getSpritesheets()) {
+        auto png = name + ".png";
+        auto plist = name + ".plist";
+
+        // fullPathForFilename caches its results, so it's only safe to call
+        // on the main thread
+        std::string pngPath = ccfu->fullPathForFilename(png.c_str(), false);
+        std::string plistPath = ccfu->fullPathForFilename(plist.c_str(), false);
+        if (png == pngPath || plist == plistPath) {
+            log::warn(
+                R"(The resource dir of "{}" is missing "{}" png and/or plist files)",
+                mod->getID(), name
+            );
+            continue;
+        }
+
+        auto sheet = std::make_unique<Sheet>();
+        sheet->name = name;
+        sheet->pngPath = std::move(pngPath);
+        sheet->plistPath = std::move(plistPath);
+        sheet->cached = CCTextureCache::get()->textureForKey(sheet->pngPath.c_str()) != nullptr;
+        m_batch->sheets.push_back(std::move(sheet));
+    }
+}
+
+void SpritesheetDecoder::setPackingEnabled(bool enabled) {
+    m_packingEnabled = enabled;
+}
+
+void SpritesheetDecoder::start() {
+    if (!m_batch || m_batch->sheets.empty()) {
+        return;
+    }
+    auto workerCount = std::clamp<size_t>(
+        std::thread::hardware_concurrency(), 1, std::min<size_t>(4, m_batch->sheets.size())
+    );
+    for (size_t i = 0; i < workerCount; i++) {
+        std::thread([batch = m_batch]() {
+            thread::setName("Spritesheet Decode");
+            while (true) {
+                auto index = batch->nextSheet.fetch_add(1, std::memory_order_relaxed);
+                if (index >= batch->sheets.size()) {
+                    break;
+                }
+                auto& sheet = *batch->sheets[index];
+                decode(sheet);
+                sheet.decoded.store(true, std::memory_order_release);
+            }
+        }).detach();
+    }
+}
+
+void SpritesheetDecoder::decode(Sheet& sheet) {
+    if (sheet.cached) {
+        return;
+    }
+    TraceSpan span("Decode spritesheet", sheet.name);
+
+    // cocos' own addImageAsync decodes images on its loading thread the same
+    // way; nothing here is autoreleased, since the pool is main thread only
+    auto image = new CCImage();
+    if (image->initWithImageFileThreadSafe(sheet.pngPath.c_str(), CCImage::kFmtPng)) {
+        sheet.image = image;
+    }
+    else {
+        image->release();
+    }
+
+    // the path is absolute, so this doesn't touch the file utils' path cache
+    auto dict = CCDictionary::createWithContentsOfFileThreadSafe(sheet.plistPath.c_str());
+    if (dict) {
+        sheet.framesParsed = parseFrames(sheet, dict);
+        dict->release();
+    }
+}
+
+// Mirrors CCSpriteFrameCache::addSpriteFramesWithDictionary, which is private
+bool SpritesheetDecoder::parseFrames(Sheet& sheet, CCDictionary* dict) {
+    // valueForKey autoreleases an empty string for missing keys, so only
+    // objectForKey is used here
+    auto getString = [](CCDictionary* dict, char const* key) -> char const* {
+        auto str = typeinfo_cast<CCString*>(dict->objectForKey(key));
+        return str ? str->getCString() : "";
+    };
+    auto getFloat = [](CCDictionary* dict, char const* key) {
+        auto str = typeinfo_cast<CCString*>(dict->objectForKey(key));
+        return str ? str->floatValue() : 0.f;
+    };
+    auto getBool = [](CCDictionary* dict, char const* key) {
+        auto str = typeinfo_cast<CCString*>(dict->objectForKey(key));
+        return str && str->boolValue();
+    };
+
+    auto framesDict = typeinfo_cast<CCDictionary*>(dict->objectForKey("frames"));
+    if (!framesDict) {
+        return false;
+    }
+    int format = 0;
+    if (auto metadata = typeinfo_cast<CCDictionary*>(dict->objectForKey("metadata"))) {
+        format = std::atoi(getString(metadata, "format"));
+    }
+    if (format < 0 || format > 3) {
+        return false;
+    }
+
+    CCDictElement* element = nullptr;
+    CCDICT_FOREACH(framesDict, element) {
+        auto frameDict = typeinfo_cast<CCDictionary*>(element->getObject());
+        if (!frameDict) {
+            return false;
+        }
+        Frame frame;
+        frame.name = element->getStrKey();
+        if (format == 0) {
+            frame.rect = CCRectMake(
+                getFloat(frameDict, "x"), getFloat(frameDict, "y"),
+                getFloat(frameDict, "width"), getFloat(frameDict, "height")
+            );
+            frame.rotated = false;
+            frame.offset = ccp(getFloat(frameDict, "offsetX"), getFloat(frameDict, "offsetY"));
+            frame.originalSize = CCSizeMake(
+                std::abs(static_cast<int>(getFloat(frameDict, "originalWidth"))),
+                std::abs(static_cast<int>(getFloat(frameDict, "originalHeight")))
+            );
+        }
+        else if (format == 1 || format == 2) {
+            frame.rect = CCRectFromString(getString(frameDict, "frame"));
+            frame.rotated = format == 2 && getBool(frameDict, "rotated");
+            frame.offset = CCPointFromString(getString(frameDict, "offset"));
+            frame.originalSize = CCSizeFromString(getString(frameDict, "sourceSize"));
+        }
+        else {
+            // aliases are stored in a dictionary the frame cache doesn't
+            // expose, so sheets using them are left to cocos
+            auto aliases = typeinfo_cast<CCArray*>(frameDict->objectForKey("aliases"));
+            if (aliases && aliases->count() > 0) {
+                return false;
+            }
+            auto spriteSize = CCSizeFromString(getString(frameDict, "spriteSize"));
+            auto textureRect = CCRectFromString(getString(frameDict, "textureRect"));
+            frame.rect = CCRectMake(
+                textureRect.origin.x, textureRect.origin.y, spriteSize.width, spriteSize.height
+            );
+            frame.rotated = getBool(frameDict, "textureRotated");
+            frame.offset = CCPointFromString(getString(frameDict, "spriteOffset"));
+            frame.originalSize = CCSizeFromString(getString(frameDict, "spriteSourceSize"));
+        }
+        sheet.frames.push_back(std::move(frame));
+    }
+    return true;
+}
+
+void SpritesheetDecoder::packSmallSheets() {
+    TraceSpan span("Pack spritesheets");
+
+    struct Region {
+        // where the region is in the sheet's image, and where it goes in
+        // the atlas (including padding)
+        RectPacker::Rect source;
+        RectPacker::Rect target;
+    };
+    struct PendingAtlas {
+        RectPacker packer;
+        bool premultiplied;
+        // regions to copy, per sheet
+        std::vector<std::pair<Sheet*, std::vector<Region>>> sheets;
+    };
+    std::vector<PendingAtlas> pending;
+
+    std::vector<Sheet*> candidates;
+    for (auto& sheet : m_batch->sheets) {
+        auto image = sheet->image;
+        if (
+            image && sheet->framesParsed && !sheet->frames.empty() &&
+            image->hasAlpha() && image->getBitsPerComponent() == 8 &&
+            static_cast<uint32_t>(image->getWidth()) * image->getHeight() <= MAX_PACKED_SHEET_AREA
+        ) {
+            candidates.push_back(sheet.get());
+        }
+    }
+    // bigger sheets first packs tighter
+    std::stable_sort(candidates.begin(), candidates.end(), [](Sheet* a, Sheet* b) {
+        return a->image->getWidth() * a->image->getHeight() > b->image->getWidth() * b->image->getHeight();
+    });
+
+    size_t packedCount = 0;
+    for (auto sheet : candidates) {
+        uint32_t imageWidth = sheet->image->getWidth();
+        uint32_t imageHeight = sheet->image->getHeight();
+
+        // frames can share a region of the sheet, so those are only copied once
+        std::vector<Region> regions;
+        std::vector<size_t> frameRegions;
+        bool valid = true;
+        for (auto const& frame : sheet->frames) {
+            auto x = std::lround(frame.rect.origin.x);
+            auto y = std::lround(frame.rect.origin.y);
+            auto width = std::lround(frame.rotated ? frame.rect.size.height : frame.rect.size.width);
+            auto height = std::lround(frame.rotated ? frame.rect.size.width : frame.rect.size.height);
+            if (x < 0 || y < 0 || width <= 0 || height <= 0 || x + width > imageWidth || y + height > imageHeight) {
+                valid = false;
+                break;
+            }
+            RectPacker::Rect source {
+                static_cast<uint32_t>(x), static_cast<uint32_t>(y),
+                static_cast<uint32_t>(width), static_cast<uint32_t>(height)
+            };
+            auto existing = std::find_if(regions.begin(), regions.end(), [&](Region const& region) {
+                return region.source.x == source.x && region.source.y == source.y &&
+                    region.source.width == source.width && region.source.height == source.height;
+            });
+            frameRegions.push_back(existing - regions.begin());
+            if (existing == regions.end()) {
+                regions.push_back({ source, {} });
+            }
+        }
+        if (!valid) {
+            continue;
+        }
+
+        std::vector<size_t> order(regions.size());
+        for (size_t i = 0; i < order.size(); i++) {
+            order[i] = i;
+        }
+        std::stable_sort(order.begin(), order.end(), [&](size_t a, size_t b) {
+            return std::max(regions[a].source.width, regions[a].source.height) >
+                std::max(regions[b].source.width, regions[b].source.height);
+        });
+        // place the whole sheet in one atlas or not at all
+        auto tryPack = [&](RectPacker packer) -> std::optional<RectPacker> {
+            for (auto i : order) {
+                auto target = packer.insert(
+                    regions[i].source.width + ATLAS_PADDING * 2,
+                    regions[i].source.height + ATLAS_PADDING * 2
+                );
+                if (!target) {
+                    return std::nullopt;
+                }
+                regions[i].target = *target;
+            }
+            return packer;
+        };
+
+        bool premultiplied = sheet->image->isPremultipliedAlpha();
+        std::optional<size_t> atlasIndex;
+        for (size_t i = 0; i < pending.size() && !atlasIndex; i++) {
+            if (pending[i].premultiplied != premultiplied) {
+                continue;
+            }
+            if (auto packer = tryPack(pending[i].packer)) {
+                pending[i].packer = std::move(*packer);
+                atlasIndex = i;
+            }
+        }
+        if (!atlasIndex) {
+            auto packer = tryPack(RectPacker(ATLAS_SIZE, ATLAS_SIZE));
+            if (!packer) {
+                continue;
+            }
+            pending.push_back({ std::move(*packer), premultiplied, {} });
+            atlasIndex = pending.size() - 1;
+        }
+
+        for (size_t i = 0; i < sheet->frames.size(); i++) {
+            auto& target = regions[frameRegions[i]].target;
+            sheet->frames[i].rect.origin = ccp(target.x + ATLAS_PADDING, target.y + ATLAS_PADDING);
+        }
+        sheet->atlas = static_cast<int>(m_atlases.size() + *atlasIndex);
+        pending[*atlasIndex].sheets.push_back({ sheet, std::move(regions) });
+        packedCount += 1;
+    }
+
+    double occupancy = 0;
+    for (auto& atlas : pending) {
+        occupancy += atlas.packer.getOccupancy();
+        auto image = AtlasImage::create(ATLAS_SIZE, ATLAS_SIZE, atlas.premultiplied);
+        auto dst = image->getData();
+        for (auto& [sheet, regions] : atlas.sheets) {
+            auto src = sheet->image->getData();
+            size_t srcStride = sheet->image->getWidth() * 4;
+            for (auto const& region : regions) {
+                auto& source = region.source;
+                auto& target = region.target;
+                for (uint32_t row = 0; row < target.height; row++) {
+                    // rows in the padding repeat the region's edge rows
+                    auto srcRow = static_cast<uint32_t>(std::clamp<int64_t>(
+                        static_cast<int64_t>(row) - ATLAS_PADDING, 0, source.height - 1
+                    )) + source.y;
+                    auto srcPixels = src + srcRow * srcStride + source.x * 4;
+                    auto dstPixels = dst + ((target.y + row) * ATLAS_SIZE + target.x) * 4;
+                    for (uint32_t i = 0; i < ATLAS_PADDING; i++) {
+                        std::memcpy(dstPixels + i * 4, srcPixels, 4);
+                        std::memcpy(
+                            dstPixels + (ATLAS_PADDING + source.width + i) * 4,
+                            srcPixels + (source.width - 1) * 4, 4
+                        );
+                    }
+                    std::memcpy(dstPixels + ATLAS_PADDING * 4, srcPixels, source.width * 4);
+                }
+            }
+            sheet->image->release();
+            sheet->image = nullptr;
+        }
+        m_atlases.push_back({
+            fmt::format("geode.loader/spritesheet-atlas-{}", m_atlases.size()), image, nullptr
+        });
+    }
+
+    if (!pending.empty()) {
+        log::debug(
+            "Packed {} spritesheets into {} atlases ({:.0f}% occupied)",
+            packedCount, pending.size(), occupancy / pending.size() * 100
+        );
+    }
+}
+
+void SpritesheetDecoder::upload(Sheet& sheet) {
+    TraceSpan span("Upload spritesheet", sheet.name);
+
+    auto textureCache = CCTextureCache::get();
+    auto frameCache = CCSpriteFrameCache::get();
+
+    if (!sheet.cached && !sheet.image && sheet.atlas == -1) {
+        log::warn("Unable to decode {} in the background, loading it normally", sheet.pngPath);
+        textureCache->addImage(sheet.pngPath.c_str(), false);
+        frameCache->addSpriteFramesWithFile(sheet.plistPath.c_str());
+        return;
+    }
+
+    CCTexture2D* texture = nullptr;
+    if (sheet.atlas != -1) {
+        auto& atlas = m_atlases[sheet.atlas];
+        if (!atlas.texture) {
+            // addUIImage keeps the image around on platforms that need to
+            // recreate textures when the GL context is lost
+            atlas.texture = textureCache->addUIImage(atlas.image, atlas.key.c_str());
+            atlas.image->release();
+            atlas.image = nullptr;
+        }
+        texture = atlas.texture;
+    }
+    else {
+        texture = textureCache->textureForKey(sheet.pngPath.c_str());
+    }
+    if (!texture) {
+        // same as what CCTextureCache does for its async loads
+        texture = new CCTexture2D();
+        texture->initWithImage(sheet.image);
+#if CC_ENABLE_CACHE_TEXTURE_DATA
+        VolatileTexture::addImageTexture(texture, sheet.pngPath.c_str(), CCImage::kFmtPng);
+#endif
+        textureCache->m_pTextures->setObject(texture, sheet.pngPath);
+        texture->release();
+    }
+    if (sheet.image) {
+        sheet.image->release();
+        sheet.image = nullptr;
+    }
+
+    if (!sheet.framesParsed) {
+        frameCache->addSpriteFramesWithFile(sheet.plistPath.c_str(), texture);
+        return;
+    }
+    for (auto const& frame : sheet.frames) {
+        // same as addSpriteFramesWithFile, frames that are already cached are 
+        // never replaced, so sheets from earlier mods keep priority. The 
+        // loaded plist set isn't touched, since it's GD's own std::set
+        if (frameCache->m_pSpriteFrames->objectForKey(frame.name)) {
+            continue;
+        }
+        frameCache->addSpriteFrame(
+            CCSpriteFrame::createWithTexture(
+                texture, frame.rect, frame.rotated, frame.offset, frame.originalSize
+            ),
+            frame.name.c_str()
+        );
+    }
+}
+
+bool SpritesheetDecoder::uploadDecoded(std::chrono::nanoseconds budget) {
+    if (!m_batch) {
+        return true;
+    }
+    auto begin = std::chrono::steady_clock::now();
+    auto& sheets = m_batch->sheets;
+    if (m_packingEnabled && !m_packed) {
+        for (auto& sheet : sheets) {
+            if (!sheet->decoded.load(std::memory_order_acquire)) {
+                return false;
+            }
+        }
+        this->packSmallSheets();
+        m_packed = true;
+    }
+    while (m_uploadedCount < sheets.size()) {
+        auto& sheet = *sheets[m_uploadedCount];
+        if (!sheet.decoded.load(std::memory_order_acquire)) {
+            return false;
+        }
+        upload(sheet);
+        m_uploadedCount += 1;
+        if (std::chrono::steady_clock::now() - begin >= budget) {
+            break;
+        }
+    }
+    if (m_uploadedCount < sheets.size()) {
+        return false;
+    }
+    m_batch = nullptr;
+    m_atlases.clear();
+    return true;
+}
@@ -0,0 +1,99 @@
+#pragma once
+
+#include <Geode/loader/Mod.hpp>
+#include <cocos2d.h>
+#include <atomic>
+#include <chrono>
+#include <memory>
+#include <string>
+#include <vector>
+
+using namespace geode::prelude;
+
+/**
+ * Loads mods' spritesheets with the expensive parts moved off the main
+ * thread. PNG decoding and plist parsing run on a few worker threads, and
+ * the main thread only uploads the decoded textures and adds their frames to
+ * the frame cache, a few sheets per frame so the loading screen keeps
+ * drawing. Used for the loading screen; mods enabled later still load their
+ * sheets synchronously through Loader::Impl::updateModResources.
+ *
+ * Optionally, small sheets can be packed together into a few shared atlases
+ * before they're uploaded, so sprites from different mods can be batched
+ * and don't each need their own texture bind. Their frames then point into
+ * the atlases, which callers of CCSprite::createWithSpriteFrameName don't
+ * notice
+ */
+class SpritesheetDecoder final {
+protected:
+    struct Frame {
+        std::string name;
+        CCRect rect;
+        bool rotated;
+        CCPoint offset;
+        CCSize originalSize;
+    };
+    struct Sheet {
+        std::string name;
+        std::string pngPath;
+        std::string plistPath;
+        // already in the texture cache, so nothing needs decoding
+        bool cached = false;
+        // owned by the sheet until it's uploaded
+        CCImage* image = nullptr;
+        // false if the plist uses a format or feature we don't parse
+        // ourselves, in which case cocos parses it again when uploading
+        bool framesParsed = false;
+        std::vector<Frame> frames;
+        // index of the atlas this sheet's frames were packed into
+        int atlas = -1;
+        std::atomic<bool> decoded = false;
+    };
+    struct Atlas {
+        std::string key;
+        // owned by the atlas until it's uploaded
+        CCImage* image = nullptr;
+        CCTexture2D* texture = nullptr;
+    };
+    // shared with the worker threads, which are detached
+    struct Batch {
+        std::vector<std::unique_ptr<Sheet>> sheets;
+        std::atomic<size_t> nextSheet = 0;
+    };
+
+    std::shared_ptr<Batch> m_batch;
+    size_t m_uploadedCount = 0;
+    bool m_packingEnabled = false;
+    bool m_packed = false;
+    std::vector<Atlas> m_atlases;
+
+    static void decode(Sheet& sheet);
+    static bool parseFrames(Sheet& sheet, CCDictionary* dict);
+    void packSmallSheets();
+    void upload(Sheet& sheet);
+
+public:
+    static SpritesheetDecoder* get();
+
+    /**
+     * Resolve the paths of a mod's spritesheets and queue them for decoding.
+     * The mod's resources directory must already be a search path
+     */
+    void queue(Mod* mod);
+    /**
+     * Pack small sheets into shared atlases before uploading them. Packing
+     * waits for every queued sheet to be decoded
+     */
+    void setPackingEnabled(bool enabled);
+    /**
+     * Start decoding everything queued so far on worker threads
+     */
+    void start();
+    /**
+     * Upload decoded sheets, in the order they were queued, until the time
+     * budget runs out. At least one sheet is uploaded per call if one is
+     * ready
+     * @returns True if every queued sheet has been uploaded
+     */
+    bool uploadDecoded(std::chrono::nanoseconds budget);
+};
@@ -4,6 +4,7 @@
 #include <resources.hpp>
 #include <hash.hpp>
 #include <utility>
+#include <thread>
 #include "LoaderImpl.hpp"
 #include "ModMetadataImpl.hpp"
 #include <Geode/utils/string.hpp>
@@ -236,19 +237,49 @@ bool updater::verifyLoaderResources() {
     // make sure every file was covered
     size_t coverage = 0;
 
-    // verify hashes
+    struct ResourceFile {
+        std::string name;
+        ghc::filesystem::path path;
+        Result<std::string> hash = Ok(std::string());
+    };
+    std::vector<ResourceFile> files;
     for (auto& file : ghc::filesystem::directory_iterator(resourcesDir)) {
         auto name = file.path().filename().string();
         // skip unknown files
         if (!LOADER_RESOURCE_HASHES.count(name)) {
             continue;
         }
-        // verify hash
-        // if we hash anything other than text, change this
-        auto hash = calculateSHA256Text(file.path());
-        const auto& expected = LOADER_RESOURCE_HASHES.at(name);
-        if (hash != expected) {
-            log::debug("Resource hash mismatch: {} ({}, {})", name, hash.substr(0, 7), expected.substr(0, 7));
+        files.push_back({ name, file.path() });
+    }
+
+    // hash files in parallel since there are a lot of them
+    std::atomic_size_t next = 0;
+    auto hashFiles = [&]() {
+        for (size_t i = next++; i < files.size(); i = next++) {
+            // if we hash anything other than text, change this
+            files[i].hash = calculateSHA256Text(files[i].path);
+        }
+    };
+    std::vector<std::thread> workers;
+    auto workerCount = std::min<size_t>(std::thread::hardware_concurrency(), files.size());
+    for (size_t i = 1; i < workerCount; i++) {
+        workers.emplace_back(hashFiles);
+    }
+    hashFiles();
+    for (auto& worker : workers) {
+        worker.join();
+    }
+
+    // verify hashes
+    for (auto& file : files) {
+        const auto& expected = LOADER_RESOURCE_HASHES.at(file.name);
+        if (!file.hash) {
+            log::debug("Unable to hash resource {}: {}", file.name, file.hash.unwrapErr());
+            updater::downloadLoaderResources();
+            return false;
+        }
+        if (file.hash.unwrap() != expected) {
+            log::debug("Resource hash mismatch: {} ({}, {})", file.name, file.hash.unwrap().substr(0, 7), expected.substr(0, 7));
             updater::downloadLoaderResources();
             return false;
         }
@@ -2,6 +2,7 @@
 #include "../../c++stl/string-impl.hpp"
 #include "internalString.hpp"
 #include <assert.h>
+#include <algorithm>
 
 #if defined(GEODE_IS_ANDROID32)
 static auto constexpr NEW_SYM = "_Znwj";
@@ -127,7 +128,10 @@ namespace geode::stl {
         return data.m_data[-1].m_size;
     }
     void StringImpl::setSize(size_t size) {
-        // TODO: implement this, remember its copy-on-write...
+        // only valid once reserve has made the storage unique, since the 
+        // representation may be shared with other strings
+        if (data.m_data == emptyInternalString()) return;
+        data.m_data[-1].m_size = size;
     }
 
     size_t StringImpl::getCapacity() {
@@ -136,4 +140,32 @@ namespace geode::stl {
     void StringImpl::setCapacity(size_t cap) {
         // TODO: implement this, remember its copy-on-write...
     }
+
+    void StringImpl::reserve(size_t cap) {
+        auto current = data.m_data;
+        auto size = current ? current[-1].m_size : 0;
+        // a refcount above 0 means other strings share this representation, 
+        // and the empty representation is shared by every empty string
+        auto unique = current != nullptr && current != emptyInternalString() &&
+            current[-1].m_refcount <= 0;
+        if (unique && current[-1].m_capacity >= cap) return;
+
+        cap = std::max(cap, size);
+        if (cap == 0) return;
+
+        StringData::Internal internal;
+        internal.m_size = size;
+        internal.m_capacity = cap;
+        internal.m_refcount = 0;
+
+        auto* buffer = static_cast<char*>(gd::operatorNew(cap + 1 + sizeof(internal)));
+        std::memcpy(buffer, &internal, sizeof(internal));
+        if (size) {
+            std::memcpy(buffer + sizeof(internal), current, size);
+        }
+        buffer[sizeof(internal) + size] = 0;
+
+        this->free();
+        data.m_data = reinterpret_cast<StringData::Internal*>(buffer + sizeof(internal));
+    }
 }
@@ -9,7 +9,7 @@ namespace geode::stl {
 
     void StringImpl::free() {
         if (data.m_capacity > 15) {
-            delete data.m_bigStorage;
+            operator delete(data.m_bigStorage);
         }
     }
 
@@ -40,4 +40,15 @@ namespace geode::stl {
     void StringImpl::setCapacity(size_t cap) {
         data.m_capacity = cap;
     }
+
+    void StringImpl::reserve(size_t cap) {
+        // the small buffer always has room for 15 characters
+        if (cap <= data.m_capacity) return;
+
+        auto storage = static_cast<char*>(operator new(cap + 1));
+        std::memcpy(storage, getStorage(), data.m_size + 1);
+        this->free();
+        data.m_bigStorage = storage;
+        data.m_capacity = cap;
+    }
 }
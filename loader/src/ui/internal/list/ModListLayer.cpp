@@ -29,9 +29,9 @@ static ModListType g_tab = ModListType::Installed;
 
 // Mods
 
-static std::optional<int> fuzzyMatch(std::string const& kw, std::string const& str) {
+static std::optional<int> fuzzyMatch(std::string const& kw, char const* str) {
     int score;
-    if (fts::fuzzy_match(kw.c_str(), str.c_str(), score)) {
+    if (fts::fuzzy_match(kw.c_str(), str, score)) {
         return score;
     }
     return std::nullopt;
@@ -46,23 +46,27 @@ static std::optional<int> queryMatchKeywords(
     // fuzzy match keywords
     if (query.keywords) {
         bool someMatched = false;
-        auto weightedMatch = [&](std::string const& str, double weight) {
+        auto weightedMatch = [&](char const* str, double weight) {
             if (auto match = fuzzyMatch(query.keywords.value(), str)) {
                 weighted = std::max<double>(match.value() * weight, weighted);
                 someMatched = true;
             }
         };
-        weightedMatch(metadata.getName(), 2);
-        weightedMatch(metadata.getID(), 1);
-        weightedMatch(ranges::join(metadata.getDevelopers(), " "), 0.5);
-        weightedMatch(metadata.getDetails().value_or(""), 0.05);
-        weightedMatch(metadata.getDescription().value_or(""), 0.2);
+        // match against the metadata's own strings rather than copies of 
+        // them, since this runs for every mod on every keystroke
+        auto const& details = metadata.getDetailsRef();
+        auto const& description = metadata.getDescriptionRef();
+        weightedMatch(metadata.getNameRef().c_str(), 2);
+        weightedMatch(metadata.getIDRef().c_str(), 1);
+        weightedMatch(ranges::join(metadata.getDevelopersRef(), " ").c_str(), 0.5);
+        weightedMatch(details ? details->c_str() : "", 0.05);
+        weightedMatch(description ? description->c_str() : "", 0.2);
         if (!someMatched) {
             return std::nullopt;
         }
     }
     else {
-        if (metadata.getID() == "geode.loader") {
+        if (metadata.getIDRef() == "geode.loader") {
             return INT_MAX;
         }
         // this is like the dumbest way you could possibly sort alphabetically 
@@ -70,8 +74,9 @@ static std::optional<int> queryMatchKeywords(
         // sorted, at least enough so that if you're scrolling it based on 
         // alphabetical order you will find the part you're looking for easily 
         // so it's fine
-        return (static_cast<int>(-tolower(metadata.getName()[0])) * 256)
-            + (metadata.getName().size() > 1 ? static_cast<int>(-tolower(metadata.getName()[1])) : 0);
+        auto const& name = metadata.getNameRef();
+        return (static_cast<int>(-tolower(name[0])) * 256)
+            + (name.size() > 1 ? static_cast<int>(-tolower(name[1])) : 0);
     }
 
     // if the weight is relatively small we can ignore it
@@ -87,12 +92,12 @@ static std::optional<int> queryMatch(ModListQuery const& query, Mod* mod) {
     // Only checking keywords makes sense for mods since their 
     // platform always matches, they are always visible and they don't 
     // currently list their tags
-    return queryMatchKeywords(query, mod->getMetadata());
+    return queryMatchKeywords(query, mod->getMetadataRef());
 }
 
 static std::optional<int> queryMatch(ModListQuery const& query, IndexItemHandle item) {
     // if no force visibility was provided and item is already installed, don't show it
-    if (!query.forceVisibility && Loader::get()->isModInstalled(item->getMetadata().getID())) {
+    if (!query.forceVisibility && Loader::get()->isModInstalled(item->getMetadataRef().getIDRef())) {
         return std::nullopt;
     }
     // make sure all tags match
@@ -118,7 +123,7 @@ static std::optional<int> queryMatch(ModListQuery const& query, IndexItemHandle
         return std::nullopt;
     }
     // otherwise match keywords
-    if (auto match = queryMatchKeywords(query, item->getMetadata())) {
+    if (auto match = queryMatchKeywords(query, item->getMetadataRef())) {
         auto weighted = match.value();
         // add extra weight on tag matches
         if (query.keywords) {
@@ -165,11 +170,11 @@ CCArray* ModListLayer::createModCells(ModListType type, ModListQuery const& quer
             // newly installed
             for (auto const& item : Index::get()->getItems()) {
                 if (!item->isInstalled() ||
-                    Loader::get()->isModInstalled(item->getMetadata().getID()) ||
-                    Loader::get()->isModLoaded(item->getMetadata().getID()))
+                    Loader::get()->isModInstalled(item->getMetadataRef().getIDRef()) ||
+                    Loader::get()->isModLoaded(item->getMetadataRef().getIDRef()))
                     continue;
                 // match the same as other installed mods
-                if (auto match = queryMatchKeywords(query, item->getMetadata())) {
+                if (auto match = queryMatchKeywords(query, item->getMetadataRef())) {
                     auto cell = IndexItemCell::create(item, this, m_display, this->getCellSize());
                     sorted.insert({ match.value(), cell });
                 }
@@ -297,8 +297,10 @@ JsonMaybeValue JsonMaybeObject::needs(std::string const& key) {
 
 
 // TODO: gross hack :3 (ctrl+f this comment to find the other part)
-extern bool s_jsonCheckerShouldCheckUnknownKeys;
-bool s_jsonCheckerShouldCheckUnknownKeys = true;
+// thread_local since the index thread and snapshot readers on other threads 
+// both toggle it around their own parsing
+extern thread_local bool s_jsonCheckerShouldCheckUnknownKeys;
+thread_local bool s_jsonCheckerShouldCheckUnknownKeys = true;
 void JsonMaybeObject::checkUnknownKeys() {
     if (!s_jsonCheckerShouldCheckUnknownKeys)
         return;
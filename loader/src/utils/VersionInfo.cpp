@@ -65,52 +65,123 @@ std::string VersionTag::toString() const {
 
 // VersionInfo
 
-Result<VersionInfo> VersionInfo::parse(std::string const& string) {
-    std::stringstream str (string);
+namespace {
+    // Reads a version string without allocating. This accepts exactly what
+    // the old std::stringstream based parser did, including its quirks:
+    // whitespace before a number is skipped and numbers may have a sign
+    struct VersionReader final {
+        std::string_view str;
+        size_t pos = 0;
+
+        bool atEnd() const {
+            return pos >= str.size();
+        }
+        char peek() const {
+            return atEnd() ? '\0' : str[pos];
+        }
+        bool consume(char c) {
+            if (!atEnd() && str[pos] == c) {
+                pos += 1;
+                return true;
+            }
+            return false;
+        }
+
+        std::optional<size_t> readNumber() {
+            while (!atEnd() && std::string_view(" \t\n\v\f\r").find(str[pos]) != std::string_view::npos) {
+                pos += 1;
+            }
+            bool negative = false;
+            if (!consume('+')) {
+                negative = consume('-');
+            }
+            if (atEnd() || peek() < '0' || peek() > '9') {
+                return std::nullopt;
+            }
+            size_t num = 0;
+            while (!atEnd() && '0' <= peek() && peek() <= '9') {
+                size_t digit = peek() - '0';
+                if (num > (SIZE_MAX - digit) / 10) {
+                    return std::nullopt;
+                }
+                num = num * 10 + digit;
+                pos += 1;
+            }
+            // unsigned stream extraction wraps negative numbers around
+            return negative ? 0 - num : num;
+        }
+
+        Result<VersionTag> readTag() {
+            auto start = pos;
+            while ('a' <= peek() && peek() <= 'z') {
+                pos += 1;
+            }
+            auto iden = str.substr(start, pos - start);
+            VersionTag tag = VersionTag::Alpha;
+            if (iden == "alpha") {
+                tag = VersionTag::Alpha;
+            }
+            else if (iden == "beta") {
+                tag = VersionTag::Beta;
+            }
+            else if (iden == "prerelease" || iden == "pr") {
+                tag = VersionTag::Prerelease;
+            }
+            else {
+                return Err("Invalid tag \"{}\"", iden);
+            }
+            if (consume('.')) {
+                auto num = readNumber();
+                if (!num) {
+                    return Err("Unable to parse tag number");
+                }
+                tag.number = *num;
+            }
+            return Ok(tag);
+        }
+    };
+}
+
+Result<VersionInfo> VersionInfo::parse(std::string_view string) {
+    VersionReader reader { string };
 
     // allow leading v
-    if (str.peek() == 'v') {
-        str.get();
-    }
+    reader.consume('v');
 
-    size_t major;
-    str >> major;
-    if (str.fail()) {
+    auto major = reader.readNumber();
+    if (!major) {
         return Err("Unable to parse major");
     }
 
-    if (str.get() != '.') {
+    if (!reader.consume('.')) {
         return Err("Minor version missing");
     }
 
-    size_t minor;
-    str >> minor;
-    if (str.fail()) {
+    auto minor = reader.readNumber();
+    if (!minor) {
         return Err("Unable to parse minor");
     }
 
-    if (str.get() != '.') {
+    if (!reader.consume('.')) {
         return Err("Patch version missing");
     }
 
-    size_t patch;
-    str >> patch;
-    if (str.fail()) {
+    auto patch = reader.readNumber();
+    if (!patch) {
         return Err("Unable to parse patch");
     }
 
     // tag
     std::optional<VersionTag> tag;
-    if (str.peek() == '-') {
-        str.get();
-        GEODE_UNWRAP_INTO(tag, VersionTag::parse(str));
+    if (reader.consume('-')) {
+        GEODE_UNWRAP_INTO(tag, reader.readTag());
     }
 
-    if (!str.eof()) {
-        return Err("Expected end of version, found '" + std::string(1, str.get()) + "'");
+    if (!reader.atEnd()) {
+        return Err("Expected end of version, found '{}'", reader.peek());
     }
 
-    return Ok(VersionInfo(major, minor, patch, tag));
+    return Ok(VersionInfo(*major, *minor, *patch, tag));
 }
 
 std::string VersionInfo::toString(bool includeTag) const {
@@ -130,9 +201,8 @@ std::string geode::format_as(VersionInfo const& version) {
 
 // ComparableVersionInfo
 
-Result<ComparableVersionInfo> ComparableVersionInfo::parse(std::string const& rawStr) {
+Result<ComparableVersionInfo> ComparableVersionInfo::parse(std::string_view string) {
     VersionCompare compare;
-    auto string = rawStr;
 
     if (string == "*") {
         return Ok(ComparableVersionInfo({0, 0, 0}, VersionCompare::Any));
@@ -140,23 +210,23 @@ Result<ComparableVersionInfo> ComparableVersionInfo::parse(std::string const& ra
 
     if (string.starts_with("<=")) {
         compare = VersionCompare::LessEq;
-        string.erase(0, 2);
+        string.remove_prefix(2);
     }
     else if (string.starts_with(">=")) {
         compare = VersionCompare::MoreEq;
-        string.erase(0, 2);
+        string.remove_prefix(2);
     }
     else if (string.starts_with("=")) {
         compare = VersionCompare::Exact;
-        string.erase(0, 1);
+        string.remove_prefix(1);
     }
     else if (string.starts_with("<")) {
         compare = VersionCompare::Less;
-        string.erase(0, 1);
+        string.remove_prefix(1);
     }
     else if (string.starts_with(">")) {
         compare = VersionCompare::More;
-        string.erase(0, 1);
+        string.remove_prefix(1);
     }
     else {
         compare = VersionCompare::MoreEq;
@@ -313,30 +313,150 @@ WeakRefPool* WeakRefPool::get() {
     return inst;
 }
 
+// the pool is gone through in full at least once every this many frames
+static constexpr size_t WEAK_REF_SWEEP_FRAMES = 8;
+// but checking a few slots every frame is cheap enough to always do
+static constexpr size_t WEAK_REF_SWEEP_MIN_SLOTS = 64;
+
+static size_t hashObject(CCObject* obj, size_t mask) {
+    // objects are aligned, so the low bits of the address carry nothing; 
+    // fold the well-mixed high bits of the product back down
+    uint64_t hash = reinterpret_cast<uintptr_t>(obj) * 0x9E3779B97F4A7C15ull;
+    return static_cast<size_t>(hash ^ (hash >> 32)) & mask;
+}
+
+size_t WeakRefPool::find(CCObject* obj) const {
+    if (m_entries.empty()) {
+        return m_entries.size();
+    }
+    auto mask = m_entries.size() - 1;
+    for (auto i = hashObject(obj, mask); m_entries[i].obj; i = (i + 1) & mask) {
+        if (m_entries[i].obj == obj) {
+            return i;
+        }
+    }
+    return m_entries.size();
+}
+
+void WeakRefPool::insert(CCObject* obj, std::shared_ptr<WeakRefController> controller) {
+    // keep the table at most 3/4 full
+    if ((m_count + 1) * 4 > m_entries.size() * 3) {
+        this->rehash(std::max<size_t>(m_entries.size() * 2, 64));
+    }
+    auto mask = m_entries.size() - 1;
+    auto i = hashObject(obj, mask);
+    while (m_entries[i].obj) {
+        i = (i + 1) & mask;
+    }
+    m_entries[i] = Entry { obj, std::move(controller) };
+    m_count += 1;
+}
+
+void WeakRefPool::rehash(size_t capacity) {
+    auto old = std::exchange(m_entries, std::vector<Entry>(capacity));
+    auto mask = capacity - 1;
+    for (auto& entry : old) {
+        if (entry.obj) {
+            auto i = hashObject(entry.obj, mask);
+            while (m_entries[i].obj) {
+                i = (i + 1) & mask;
+            }
+            m_entries[i] = std::move(entry);
+        }
+    }
+    m_sweepCursor = 0;
+}
+
+void WeakRefPool::release(size_t index) {
+    auto obj = m_entries[index].obj;
+    auto controller = std::move(m_entries[index].controller);
+    m_entries[index].obj = nullptr;
+    m_count -= 1;
+
+    // shift back the entries after this one so lookups don't stop at the 
+    // hole; no tombstones means sweep never has to skip over dead slots
+    auto mask = m_entries.size() - 1;
+    auto hole = index;
+    for (auto i = (index + 1) & mask; m_entries[i].obj; i = (i + 1) & mask) {
+        auto home = hashObject(m_entries[i].obj, mask);
+        // move the entry into the hole unless its home slot lies cyclically 
+        // in (hole, i], in which case it's already reachable
+        if (((i - home) & mask) >= ((i - hole) & mask)) {
+            m_entries[hole] = std::move(m_entries[i]);
+            m_entries[i].obj = nullptr;
+            hole = i;
+        }
+    }
+
+    m_reclaimed += 1;
+    // the pool has to be consistent before releasing, since freeing the 
+    // object may free other objects that have WeakRefs to them. 
+    // WeakRefController::swap can point the controller at another object 
+    // without re-keying the pool, in which case it's still in use
+    if (controller->m_obj == obj) {
+        controller->m_obj = nullptr;
+    }
+    // set delegates to null because those aren't retained!
+    if (auto input = typeinfo_cast<CCTextInputNode*>(obj)) {
+        input->m_delegate = nullptr;
+    }
+    obj->release();
+}
+
 void WeakRefPool::check(CCObject* obj) {
     // if this object's only reference is the WeakRefPool aka only weak 
     // references exist to it, then release it
-    if (obj && m_pool.contains(obj) && obj->retainCount() == 1) {
-        // set delegates to null because those aren't retained!
-        if (auto input = typeinfo_cast<CCTextInputNode*>(obj)) {
-            input->m_delegate = nullptr;
+    if (obj && obj->retainCount() == 1) {
+        auto index = this->find(obj);
+        if (index != m_entries.size()) {
+            this->release(index);
         }
-        obj->release();
-        // log::info("nullify {}", m_pool.at(obj).get());
-        m_pool.at(obj)->m_obj = nullptr;
-        m_pool.erase(obj);
     }
 }
 
 std::shared_ptr<WeakRefController> WeakRefPool::manage(CCObject* obj) {
-    if (!m_pool.contains(obj)) {
-        CC_SAFE_RETAIN(obj);
-        auto controller = std::make_shared<WeakRefController>();
-        controller->m_obj = obj;
-        m_pool.insert({ obj, controller });
-    }
-    // log::info("get {} for {}", m_pool.at(obj).get(), obj);
-    return m_pool.at(obj);
+    auto index = this->find(obj);
+    if (index != m_entries.size()) {
+        return m_entries[index].controller;
+    }
+    CC_SAFE_RETAIN(obj);
+    auto controller = std::make_shared<WeakRefController>();
+    controller->m_obj = obj;
+    this->insert(obj, controller);
+    return controller;
+}
+
+void WeakRefPool::sweep() {
+    if (m_count == 0) {
+        return;
+    }
+    auto budget = std::max(WEAK_REF_SWEEP_MIN_SLOTS, m_entries.size() / WEAK_REF_SWEEP_FRAMES);
+    for (size_t checked = 0; checked < budget; checked++) {
+        // releasing may cause the table to be modified, so don't hold on to 
+        // anything across it
+        if (m_sweepCursor >= m_entries.size()) {
+            m_sweepCursor = 0;
+        }
+        auto& entry = m_entries[m_sweepCursor];
+        // release objects that are only kept alive by the pool, as well as 
+        // ones no WeakRef points to anymore
+        if (entry.obj && (entry.obj->retainCount() == 1 || entry.controller.use_count() == 1)) {
+            this->release(m_sweepCursor);
+            m_reclaimedBySweep += 1;
+            // an entry may have been shifted into this slot, so check it again
+            continue;
+        }
+        m_sweepCursor += 1;
+    }
+}
+
+WeakRefPool::Stats WeakRefPool::getStats() const {
+    return Stats {
+        .managed = m_count,
+        .capacity = m_entries.size(),
+        .reclaimed = m_reclaimed,
+        .reclaimedBySweep = m_reclaimedBySweep,
+    };
 }
 
 bool geode::cocos::isSpriteFrameName(CCNode* node, const char* name) {
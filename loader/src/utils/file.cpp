@@ -10,9 +10,21 @@
 #include <mz_strm_os.h>
 #include <mz_strm_mem.h>
 #include <mz_zip.h>
+#include <zlib.h>
 #include <internal/FileWatcher.hpp>
+#include <internal/MappedFile.hpp>
 #include <Geode/utils/ranges.hpp>
 #include <Geode/loader/Loader.hpp>
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <future>
+#include <mutex>
+#include <optional>
+#include <span>
+#include <thread>
+#include <utility>
 
 #ifdef GEODE_IS_WINDOWS
 #include <filesystem>
@@ -158,8 +170,230 @@ struct ZipEntry {
     bool isDirectory;
     int64_t compressedSize;
     int64_t uncompressedSize;
+    // only filled in when reading
+    uint64_t localHeaderOffset = 0;
+    uint32_t crc = 0;
+    uint16_t method = 0;
+    uint16_t flags = 0;
 };
 
+// Central directory parsing
+
+template <class T>
+static T readLE(uint8_t const* data) {
+    T value = 0;
+    for (size_t i = 0; i < sizeof(T); i++) {
+        value |= static_cast<T>(data[i]) << (i * 8);
+    }
+    return value;
+}
+
+static constexpr uint32_t ZIP_LOCAL_HEADER_SIG = 0x04034b50;
+static constexpr uint32_t ZIP_CENTRAL_HEADER_SIG = 0x02014b50;
+static constexpr uint32_t ZIP_END_SIG = 0x06054b50;
+static constexpr uint32_t ZIP64_END_SIG = 0x06064b50;
+static constexpr uint32_t ZIP64_END_LOCATOR_SIG = 0x07064b50;
+static constexpr size_t ZIP_LOCAL_HEADER_SIZE = 30;
+static constexpr size_t ZIP_CENTRAL_HEADER_SIZE = 46;
+static constexpr size_t ZIP_END_SIZE = 22;
+static constexpr size_t ZIP64_END_SIZE = 56;
+static constexpr size_t ZIP64_END_LOCATOR_SIZE = 20;
+
+// zlib takes 32-bit lengths
+static uint32_t crc32Of(uint8_t const* data, size_t size) {
+    uLong crc = crc32(0, nullptr, 0);
+    while (size) {
+        auto chunk = static_cast<uInt>(std::min<size_t>(size, UINT32_MAX));
+        crc = crc32(crc, data, chunk);
+        data += chunk;
+        size -= chunk;
+    }
+    return static_cast<uint32_t>(crc);
+}
+
+static Result<ByteVector> inflateRaw(std::span<uint8_t const> data, size_t size) {
+    z_stream stream {};
+    if (inflateInit2(&stream, -MAX_WBITS) != Z_OK) {
+        return Err("Unable to initialize inflate");
+    }
+    ByteVector res;
+    res.resize(size);
+    // inflate refuses a null output buffer even when there's nothing to 
+    // write, which is the case for empty entries
+    Bytef empty;
+    stream.next_in = const_cast<Bytef*>(data.data());
+    stream.next_out = size ? res.data() : &empty;
+    auto inLeft = data.size();
+    auto outLeft = res.size();
+    int err = Z_OK;
+    while (err == Z_OK) {
+        auto inChunk = static_cast<uInt>(std::min<size_t>(inLeft, UINT32_MAX));
+        auto outChunk = static_cast<uInt>(std::min<size_t>(outLeft, UINT32_MAX));
+        stream.avail_in = inChunk;
+        stream.avail_out = outChunk;
+        err = inflate(&stream, Z_FINISH);
+        inLeft -= inChunk - stream.avail_in;
+        outLeft -= outChunk - stream.avail_out;
+        // Z_BUF_ERROR just means one of the chunks ran out
+        if (err == Z_BUF_ERROR && inLeft && outLeft) {
+            err = Z_OK;
+        }
+    }
+    inflateEnd(&stream);
+    if (err != Z_STREAM_END || outLeft != 0) {
+        return Err("Unable to inflate entry (code {})", err);
+    }
+    return Ok(std::move(res));
+}
+
+// Parallel compression
+
+// Entries are deflated in blocks of this size, each on its own worker, and 
+// every block is primed with the end of the previous one so splitting large 
+// entries barely affects the compression ratio (the same trick pigz uses). 
+// Entries that fit in one block come out byte-for-byte the same as minizip 
+// would compress them
+static constexpr size_t ZIP_BLOCK_SIZE = 1024 * 1024;
+static constexpr size_t ZIP_DICT_SIZE = 32 * 1024;
+
+struct DeflatedBlock {
+    ByteVector data;
+    uint32_t crc;
+};
+
+// the dictionary is the dictSize bytes right before data
+static Result<DeflatedBlock> deflateBlock(uint8_t const* data, size_t size, size_t dictSize, bool last) {
+    // same parameters as minizip's zlib stream
+    z_stream stream {};
+    if (deflateInit2(
+        &stream, Z_DEFAULT_COMPRESSION, Z_DEFLATED, -MAX_WBITS, 8, Z_DEFAULT_STRATEGY
+    ) != Z_OK) {
+        return Err("Unable to initialize deflate");
+    }
+    if (dictSize) {
+        deflateSetDictionary(&stream, data - dictSize, static_cast<uInt>(dictSize));
+    }
+
+    DeflatedBlock block;
+    // a sync flush adds an empty stored block on top of the bound
+    block.data.resize(deflateBound(&stream, static_cast<uLong>(size)) + 8);
+    stream.next_in = const_cast<Bytef*>(data);
+    stream.avail_in = static_cast<uInt>(size);
+    stream.next_out = block.data.data();
+    stream.avail_out = static_cast<uInt>(block.data.size());
+
+    // blocks other than the last are ended with a sync flush, which leaves 
+    // them byte-aligned with no final bit so they can just be concatenated
+    auto err = deflate(&stream, last ? Z_FINISH : Z_SYNC_FLUSH);
+    auto written = stream.total_out;
+    auto leftIn = stream.avail_in;
+    auto leftOut = stream.avail_out;
+    deflateEnd(&stream);
+    if (err != (last ? Z_STREAM_END : Z_OK) || leftIn != 0 || leftOut == 0) {
+        return Err("Unable to deflate block (code {})", err);
+    }
+
+    block.data.resize(written);
+    block.crc = crc32(0, data, static_cast<uInt>(size));
+    return Ok(std::move(block));
+}
+
+class ZipWorkers final {
+    std::mutex m_mutex;
+    std::condition_variable m_condition;
+    std::deque<std::function<void()>> m_jobs;
+    size_t m_threadCount;
+
+    ZipWorkers() {
+        // leave a core for the game and one for the thread writing the zip
+        m_threadCount = std::clamp<size_t>(std::thread::hardware_concurrency(), 3, 10) - 2;
+        for (size_t i = 0; i < m_threadCount; i++) {
+            std::thread([this] {
+                thread::setName("Zip Worker");
+                this->work();
+            }).detach();
+        }
+    }
+
+    void work() {
+        while (true) {
+            std::function<void()> job;
+            {
+                std::unique_lock lock(m_mutex);
+                m_condition.wait(lock, [this] { return !m_jobs.empty(); });
+                job = std::move(m_jobs.front());
+                m_jobs.pop_front();
+            }
+            job();
+        }
+    }
+
+public:
+    static ZipWorkers* get() {
+        static auto inst = new ZipWorkers();
+        return inst;
+    }
+
+    size_t getThreadCount() const {
+        return m_threadCount;
+    }
+
+    std::future<Result<DeflatedBlock>> submit(
+        std::shared_ptr<ByteVector const> input, size_t offset, size_t size, bool last
+    ) {
+        auto task = std::make_shared<std::packaged_task<Result<DeflatedBlock>()>>([=] {
+            return deflateBlock(
+                input->data() + offset, size, std::min(offset, ZIP_DICT_SIZE), last
+            );
+        });
+        auto future = task->get_future();
+        {
+            std::unique_lock lock(m_mutex);
+            m_jobs.push_back([task] { (*task)(); });
+        }
+        m_condition.notify_one();
+        return future;
+    }
+};
+
+struct ZipBatchEntry {
+    Zip::Path path;
+    // the data to compress, a file to read it from, or neither for folders
+    std::variant<std::monostate, ByteVector, Zip::Path> source;
+    size_t size = 0;
+};
+
+// Uses the non-throwing filesystem calls, since this also runs on the zip
+// writer thread, where an exception would terminate the game
+static Result<> collectAllFrom(
+    Zip::Path const& dir, Zip::Path const& entry, std::vector<ZipBatchEntry>& entries
+) {
+    auto folder = entry / dir.filename();
+    entries.push_back({ .path = folder });
+    std::error_code ec;
+    auto it = ghc::filesystem::directory_iterator(dir, ec);
+    for (; !ec && it != ghc::filesystem::directory_iterator(); it.increment(ec)) {
+        auto& file = *it;
+        if (file.is_directory(ec)) {
+            GEODE_UNWRAP(collectAllFrom(file, folder, entries));
+        }
+        else {
+            // only used for progress, the file is read when it's compressed
+            std::error_code sizeError;
+            auto size = ghc::filesystem::file_size(file, sizeError);
+            entries.push_back({
+                .path = folder / file.path().filename(),
+                .source = file.path(),
+                .size = sizeError ? 0 : static_cast<size_t>(size),
+            });
+        }
+    }
+    if (ec) {
+        return Err("Unable to read directory " + dir.string() + ": " + ec.message());
+    }
+    return Ok();
+}
+
 class Zip::Impl final {
 public:
     using Path = Zip::Path;
@@ -170,8 +404,36 @@ private:
     int32_t m_mode;
     std::variant<Path, ByteVector> m_srcDest;
     std::unordered_map<Path, ZipEntry> m_entries;
+    // central directory order, for extracting everything
+    std::vector<Path> m_entryOrder;
+    // zips being read don't go through minizip at all; the central directory 
+    // is read straight from the file mapping (or the in-memory data) once, 
+    // after which lookups and extraction never touch any shared state, so 
+    // entries can be extracted from multiple threads at once
+    std::optional<MappedFile> m_mapped;
+    std::span<uint8_t const> m_readData;
+    // shared with the queued completion callback, which clears it and may 
+    // run after the zip itself is gone
+    std::shared_ptr<std::atomic_bool> m_busy = std::make_shared<std::atomic_bool>(false);
+    std::thread m_asyncThread;
 
     Result<> init() {
+        if (m_mode == MZ_OPEN_MODE_READ) {
+            if (std::holds_alternative<Path>(m_srcDest)) {
+                GEODE_UNWRAP_INTO(
+                    auto mapped, MappedFile::create(std::get<Path>(m_srcDest))
+                    .expect("Unable to read file: {error}")
+                );
+                m_mapped = std::move(mapped);
+                m_readData = std::span(m_mapped->data(), m_mapped->size());
+            }
+            else {
+                auto& src = std::get<ByteVector>(m_srcDest);
+                m_readData = std::span(src.data(), src.size());
+            }
+            return this->loadCentralDirectory().expect("Unable to read zip: {error}");
+        }
+
         // open stream from file
         if (std::holds_alternative<Path>(m_srcDest)) {
             auto& path = std::get<Path>(m_srcDest);
@@ -247,6 +509,178 @@ private:
         return true;
     }
 
+    Result<> loadCentralDirectory() {
+        auto data = m_readData.data();
+        auto size = m_readData.size();
+        if (size < ZIP_END_SIZE) {
+            return Err("File is too small to be a zip");
+        }
+
+        // the end of central directory record is followed by a comment of up 
+        // to 64KiB, so it has to be searched for from the back
+        size_t end = size - ZIP_END_SIZE;
+        auto const searchLimit = end > 0xffff ? end - 0xffff : 0;
+        while (readLE<uint32_t>(data + end) != ZIP_END_SIG) {
+            if (end == searchLimit) {
+                return Err("End of central directory not found");
+            }
+            end -= 1;
+        }
+
+        uint64_t entryCount = readLE<uint16_t>(data + end + 10);
+        uint64_t dirSize = readLE<uint32_t>(data + end + 12);
+        uint64_t dirOffset = readLE<uint32_t>(data + end + 16);
+
+        // zip64 archives keep the real values in another record
+        if (
+            end >= ZIP64_END_LOCATOR_SIZE &&
+            readLE<uint32_t>(data + end - ZIP64_END_LOCATOR_SIZE) == ZIP64_END_LOCATOR_SIG
+        ) {
+            auto end64 = readLE<uint64_t>(data + end - ZIP64_END_LOCATOR_SIZE + 8);
+            if (
+                end < ZIP64_END_LOCATOR_SIZE + ZIP64_END_SIZE ||
+                end64 > end - ZIP64_END_LOCATOR_SIZE - ZIP64_END_SIZE ||
+                readLE<uint32_t>(data + end64) != ZIP64_END_SIG
+            ) {
+                return Err("Invalid zip64 end of central directory");
+            }
+            entryCount = readLE<uint64_t>(data + end64 + 32);
+            dirSize = readLE<uint64_t>(data + end64 + 40);
+            dirOffset = readLE<uint64_t>(data + end64 + 48);
+        }
+        if (dirOffset > size || dirSize > size - dirOffset) {
+            return Err("Central directory is out of bounds");
+        }
+        // every entry takes up at least a header, so this also keeps a bogus 
+        // count from making the reserves below throw
+        if (entryCount > dirSize / ZIP_CENTRAL_HEADER_SIZE) {
+            return Err("Central directory entry count is invalid");
+        }
+
+        m_entries.reserve(static_cast<size_t>(entryCount));
+        m_entryOrder.reserve(static_cast<size_t>(entryCount));
+
+        auto cur = data + dirOffset;
+        auto const dirEnd = cur + dirSize;
+        for (uint64_t i = 0; i < entryCount; i++) {
+            if (
+                dirEnd - cur < static_cast<ptrdiff_t>(ZIP_CENTRAL_HEADER_SIZE) ||
+                readLE<uint32_t>(cur) != ZIP_CENTRAL_HEADER_SIG
+            ) {
+                return Err("Invalid central directory header");
+            }
+            auto madeBy = readLE<uint16_t>(cur + 4);
+            ZipEntry entry {
+                .compressedSize = readLE<uint32_t>(cur + 20),
+                .uncompressedSize = readLE<uint32_t>(cur + 24),
+                .localHeaderOffset = readLE<uint32_t>(cur + 42),
+                .crc = readLE<uint32_t>(cur + 16),
+                .method = readLE<uint16_t>(cur + 10),
+                .flags = readLE<uint16_t>(cur + 8),
+            };
+            auto nameSize = readLE<uint16_t>(cur + 28);
+            auto extraSize = readLE<uint16_t>(cur + 30);
+            auto commentSize = readLE<uint16_t>(cur + 32);
+            auto externalAttrs = readLE<uint32_t>(cur + 38);
+            if (dirEnd - cur < static_cast<ptrdiff_t>(ZIP_CENTRAL_HEADER_SIZE + nameSize + extraSize + commentSize)) {
+                return Err("Invalid central directory header");
+            }
+            auto name = cur + ZIP_CENTRAL_HEADER_SIZE;
+
+            // the zip64 extra field only has the values that overflowed, in 
+            // this order
+            auto extra = name + nameSize;
+            auto const extraEnd = extra + extraSize;
+            while (extraEnd - extra >= 4) {
+                auto id = readLE<uint16_t>(extra);
+                auto fieldSize = readLE<uint16_t>(extra + 2);
+                auto field = extra + 4;
+                if (extraEnd - field < fieldSize) {
+                    break;
+                }
+                if (id == 0x0001) {
+                    auto fieldEnd = field + fieldSize;
+                    auto read64 = [&](auto& value) {
+                        if (value == UINT32_MAX && fieldEnd - field >= 8) {
+                            value = readLE<uint64_t>(field);
+                            field += 8;
+                        }
+                    };
+                    read64(entry.uncompressedSize);
+                    read64(entry.compressedSize);
+                    read64(entry.localHeaderOffset);
+                    break;
+                }
+                extra = field + fieldSize;
+            }
+
+            // same checks as mz_zip_entry_is_dir
+            entry.isDirectory = (nameSize && (name[nameSize - 1] == '/' || name[nameSize - 1] == '\\'));
+            if ((madeBy >> 8) == 0 || (madeBy >> 8) == 10 || (madeBy >> 8) == 14) {
+                entry.isDirectory |= (externalAttrs & 0x10) != 0;
+            }
+            else if ((madeBy >> 8) == 3 || (madeBy >> 8) == 19) {
+                entry.isDirectory |= ((externalAttrs >> 16) & 0170000) == 0040000;
+            }
+
+            Path filePath;
+            filePath.assign(
+                reinterpret_cast<char const*>(name), reinterpret_cast<char const*>(name) + nameSize
+            );
+            if (m_entries.insert({ filePath, entry }).second) {
+                m_entryOrder.push_back(std::move(filePath));
+            }
+
+            cur += ZIP_CENTRAL_HEADER_SIZE + nameSize + extraSize + commentSize;
+        }
+        return Ok();
+    }
+
+    // the entry's data as it's stored in the zip
+    Result<std::span<uint8_t const>> rawEntryData(ZipEntry const& entry) const {
+        if (entry.flags & MZ_ZIP_FLAG_ENCRYPTED) {
+            return Err("Entry is encrypted");
+        }
+        auto size = m_readData.size();
+        auto offset = entry.localHeaderOffset;
+        if (
+            offset > size || size - offset < ZIP_LOCAL_HEADER_SIZE ||
+            readLE<uint32_t>(m_readData.data() + offset) != ZIP_LOCAL_HEADER_SIG
+        ) {
+            return Err("Invalid local header");
+        }
+        // the local header's name and extra field can differ from the 
+        // central directory's, so their sizes have to be read from it
+        auto start = offset + ZIP_LOCAL_HEADER_SIZE +
+            readLE<uint16_t>(m_readData.data() + offset + 26) +
+            readLE<uint16_t>(m_readData.data() + offset + 28);
+        auto compressedSize = static_cast<uint64_t>(entry.compressedSize);
+        if (start > size || size - start < compressedSize) {
+            return Err("Entry data is out of bounds");
+        }
+        return Ok(m_readData.subspan(start, compressedSize));
+    }
+
+    Result<ByteVector> readEntry(ZipEntry const& entry) const {
+        GEODE_UNWRAP_INTO(auto raw, this->rawEntryData(entry));
+
+        ByteVector res;
+        if (entry.method == MZ_COMPRESS_METHOD_STORE) {
+            res.assign(raw.begin(), raw.end());
+        }
+        else if (entry.method == MZ_COMPRESS_METHOD_DEFLATE) {
+            GEODE_UNWRAP_INTO(res, inflateRaw(raw, entry.uncompressedSize));
+        }
+        else {
+            return Err("Unsupported compression method {}", entry.method);
+        }
+
+        if (crc32Of(res.data(), res.size()) != entry.crc) {
+            return Err("Entry is corrupted (CRC mismatch)");
+        }
+        return Ok(std::move(res));
+    }
+
     static Result<> mzTry(int32_t code) {
         if (code == MZ_OK) {
             return Ok();
@@ -265,10 +699,10 @@ public:
         return Ok(std::move(ret));
     }
 
-    static Result<std::unique_ptr<Impl>> fromMemory(ByteVector const& raw) {
+    static Result<std::unique_ptr<Impl>> fromMemory(ByteVector&& raw) {
         auto ret = std::make_unique<Impl>();
         ret->m_mode = MZ_OPEN_MODE_READ;
-        ret->m_srcDest = raw;
+        ret->m_srcDest = std::move(raw);
         GEODE_UNWRAP(ret->init());
         return Ok(std::move(ret));
     }
@@ -281,28 +715,8 @@ public:
         return Ok(std::move(ret));
     }
 
-    Result<> extractAt(Path const& dir, Path const& name) {
-        auto entry = m_entries.at(name);
-
-        GEODE_UNWRAP(
-            mzTry(mz_zip_entry_read_open(m_handle, 0, nullptr))
-            .expect("Unable to open entry (code {error})")
-        );
-
-        // if the file is empty, its data is empty (duh)
-        if (!entry.uncompressedSize) {
-            return Ok();
-        }
-
-        ByteVector res;
-        res.resize(entry.uncompressedSize);
-        auto read = mz_zip_entry_read(m_handle, res.data(), entry.uncompressedSize);
-        if (read < 0) {
-            mz_zip_entry_close(m_handle);
-            return Err("Unable to read entry (code " + std::to_string(read) + ")");
-        }
-
-        mz_zip_entry_close(m_handle);
+    Result<> extractAt(Path const& dir, Path const& name) const {
+        GEODE_UNWRAP_INTO(auto res, this->readEntry(m_entries.at(name)));
 
         GEODE_UNWRAP(file::createDirectoryAll((dir / name).parent_path()));
         GEODE_UNWRAP(file::writeBinary(dir / name, res).expect("Unable to write to {}: {error}", dir / name));
@@ -310,24 +724,10 @@ public:
         return Ok();
     }
 
-    Result<> extractAllTo(Path const& dir) {
+    Result<> extractAllTo(Path const& dir) const {
         GEODE_UNWRAP(file::createDirectoryAll(dir));
 
-        GEODE_UNWRAP(
-            mzTry(mz_zip_goto_first_entry(m_handle))
-            .expect("Unable to navigate to first entry (code {error})")
-        );
-
-        // while not at MZ_END_OF_LIST
-        do {
-            mz_zip_file* info = nullptr;
-            if (mz_zip_entry_get_info(m_handle, &info) != MZ_OK) {
-                return Err("Unable to get entry info");
-            }
-
-            Path filePath;
-            filePath.assign(info->filename, info->filename + info->filename_size);
-
+        for (auto& filePath : m_entryOrder) {
             // make sure zip files like root/../../file.txt don't get extracted to 
             // avoid zip attacks
 #ifdef GEODE_IS_WINDOWS
@@ -348,54 +748,34 @@ public:
                     dir / filePath
                 );
             }
-        } while (mz_zip_goto_next_entry(m_handle) == MZ_OK);
+        }
 
         return Ok();
     }
 
-    Result<ByteVector> extract(Path const& name) {
-        if (!m_entries.count(name)) {
+    Result<ByteVector> extract(Path const& name) const {
+        auto it = m_entries.find(name);
+        if (it == m_entries.end()) {
             return Err("Entry not found");
         }
-
-        auto entry = m_entries.at(name);
-        if (entry.isDirectory) {
+        if (it->second.isDirectory) {
             return Err("Entry is directory");
         }
+        return this->readEntry(it->second);
+    }
 
-        GEODE_UNWRAP(
-            mzTry(mz_zip_goto_first_entry(m_handle))
-            .expect("Unable to navigate to first entry (code {error})")
-        );
-
-        GEODE_UNWRAP(
-            mzTry(mz_zip_locate_entry(
-                m_handle,
-                reinterpret_cast<const char*>(name.u8string().c_str()),
-                1
-            )).expect("Unable to navigate to entry (code {error})")
-        );
-
-        GEODE_UNWRAP(
-            mzTry(mz_zip_entry_read_open(m_handle, 0, nullptr))
-            .expect("Unable to open entry (code {error})")
-        );
-
-        // if the file is empty, its data is empty (duh)
-        if (!entry.uncompressedSize) {
-            return Ok(ByteVector());
+    Result<std::span<uint8_t const>> view(Path const& name) const {
+        auto it = m_entries.find(name);
+        if (it == m_entries.end()) {
+            return Err("Entry not found");
         }
-
-        ByteVector res;
-        res.resize(entry.uncompressedSize);
-        auto read = mz_zip_entry_read(m_handle, res.data(), entry.uncompressedSize);
-        if (read < 0) {
-            mz_zip_entry_close(m_handle);
-            return Err("Unable to read entry (code " + std::to_string(read) + ")");
+        if (it->second.isDirectory) {
+            return Err("Entry is directory");
         }
-        mz_zip_entry_close(m_handle);
-
-        return Ok(res);
+        if (it->second.method != MZ_COMPRESS_METHOD_STORE) {
+            return Err("Entry is compressed");
+        }
+        return this->rawEntryData(it->second);
     }
 
     Result<> addFolder(Path const& path) {
@@ -425,11 +805,28 @@ public:
         return Ok();
     }
 
+    Result<> add(Path const& path, ByteVector&& data) {
+        if (data.size() <= ZIP_BLOCK_SIZE) {
+            return this->add(path, std::as_const(data));
+        }
+        auto size = data.size();
+        std::vector<ZipBatchEntry> batch;
+        batch.push_back({ .path = path, .source = std::move(data), .size = size });
+        return this->addBatch(batch, nullptr);
+    }
+
     Result<> add(Path const& path, ByteVector const& data) {
+        // the workers share the data of large entries, so it has to be owned
+        if (data.size() > ZIP_BLOCK_SIZE) {
+            return this->add(path, ByteVector(data));
+        }
+
+        // minizip keeps the filename pointer until the entry is closed
+        auto strPath = path.u8string();
         mz_zip_file info = { 0 };
         info.version_madeby = MZ_VERSION_MADEBY;
         info.compression_method = MZ_COMPRESS_METHOD_DEFLATE;
-        info.filename = reinterpret_cast<const char*>(path.u8string().c_str());
+        info.filename = reinterpret_cast<const char*>(strPath.c_str());
         info.uncompressed_size = data.size();
         info.aes_version = MZ_AES_VERSION;
 
@@ -447,6 +844,191 @@ public:
         return Ok();
     }
 
+    Result<> addBatch(std::vector<ZipBatchEntry>& entries, Zip::Progress const& progress) {
+        auto workers = ZipWorkers::get();
+        // how far compression may run ahead of writing, which bounds how much 
+        // memory a batch can take up
+        auto const maxPending = workers->getThreadCount() * 4;
+
+        struct PendingBlock {
+            size_t entry;
+            size_t size;
+            bool first;
+            bool last;
+            // invalid for folders
+            std::future<Result<DeflatedBlock>> block;
+        };
+        std::deque<PendingBlock> pending;
+
+        size_t total = 0;
+        for (auto& entry : entries) {
+            total += entry.size;
+        }
+        size_t written = 0;
+        size_t reported = 0;
+
+        // kept alive until the entry is closed since minizip holds onto it
+        std::u8string entryName;
+        uint32_t entryCrc = 0;
+
+        // blocks are written strictly in order, so the zip is streamed out 
+        // exactly like it would be when adding entries one by one
+        auto writeNext = [&]() -> Result<> {
+            auto next = std::move(pending.front());
+            pending.pop_front();
+            auto& entry = entries[next.entry];
+            if (!next.block.valid()) {
+                return this->addFolder(entry.path);
+            }
+
+            if (next.first) {
+                entryName = entry.path.u8string();
+                entryCrc = 0;
+
+                mz_zip_file info = { 0 };
+                info.version_madeby = MZ_VERSION_MADEBY;
+                info.compression_method = MZ_COMPRESS_METHOD_DEFLATE;
+                info.filename = reinterpret_cast<const char*>(entryName.c_str());
+                info.uncompressed_size = entry.size;
+                info.aes_version = MZ_AES_VERSION;
+                // raw mode writes the already deflated data as-is
+                GEODE_UNWRAP(
+                    mzTry(mz_zip_entry_write_open(m_handle, &info, MZ_COMPRESS_LEVEL_DEFAULT, 1, nullptr))
+                    .expect("Unable to open entry for writing (code {error})")
+                );
+            }
+
+            auto block = next.block.get();
+            if (!block) {
+                mz_zip_entry_close(m_handle);
+                return Err("Unable to compress entry: {}", block.unwrapErr());
+            }
+            auto& data = block.unwrap().data;
+            auto res = mz_zip_entry_write(m_handle, data.data(), data.size());
+            if (res < 0) {
+                mz_zip_entry_close(m_handle);
+                return Err("Unable to write entry data (code " + std::to_string(res) + ")");
+            }
+            entryCrc = crc32_combine(entryCrc, block.unwrap().crc, static_cast<z_off_t>(next.size));
+
+            if (next.last) {
+                GEODE_UNWRAP(
+                    mzTry(mz_zip_entry_close_raw(m_handle, entry.size, entryCrc))
+                    .expect("Unable to close entry (code {error})")
+                );
+            }
+
+            written += next.size;
+            if (progress && (written - reported >= total / 100 || written == total)) {
+                reported = written;
+                progress(written, total);
+            }
+            return Ok();
+        };
+
+        for (size_t i = 0; i < entries.size(); i++) {
+            auto& entry = entries[i];
+            if (std::holds_alternative<std::monostate>(entry.source)) {
+                pending.push_back({ .entry = i });
+                continue;
+            }
+
+            std::shared_ptr<ByteVector const> data;
+            if (auto path = std::get_if<Path>(&entry.source)) {
+                auto bytes = file::readBinary(*path);
+                if (!bytes) {
+                    // finish off the entries before this one, so the zip 
+                    // isn't left with one that's only been partly written
+                    while (!pending.empty()) {
+                        GEODE_UNWRAP(writeNext());
+                    }
+                    return Err("Unable to read {}: {}", *path, bytes.unwrapErr());
+                }
+                data = std::make_shared<ByteVector const>(std::move(bytes.unwrap()));
+            }
+            else {
+                data = std::make_shared<ByteVector const>(std::move(std::get<ByteVector>(entry.source)));
+            }
+            // the size of a file may have changed since it was collected
+            total = total - entry.size + data->size();
+            entry.size = data->size();
+
+            // empty entries still get one (empty) block
+            size_t offset = 0;
+            do {
+                auto size = std::min(ZIP_BLOCK_SIZE, data->size() - offset);
+                while (pending.size() >= maxPending) {
+                    GEODE_UNWRAP(writeNext());
+                }
+                auto last = offset + size == data->size();
+                pending.push_back({
+                    .entry = i,
+                    .size = size,
+                    .first = offset == 0,
+                    .last = last,
+                    .block = workers->submit(data, offset, size, last),
+                });
+                offset += size;
+            } while (offset < data->size());
+        }
+        while (!pending.empty()) {
+            GEODE_UNWRAP(writeNext());
+        }
+        return Ok();
+    }
+
+    template <class Collect>
+    void addBatchAsync(Collect collect, Zip::Finished then, Zip::Progress progress) {
+        if (m_busy->exchange(true)) {
+            Loader::get()->queueInMainThread([then] {
+                then(Err("Zip is already being written to"));
+            });
+            return;
+        }
+        // the previous write is done but its thread still needs to be joined
+        if (m_asyncThread.joinable()) {
+            m_asyncThread.join();
+        }
+        m_asyncThread = std::thread([this, collect = std::move(collect), then, progress]() mutable {
+            thread::setName("Zip Writer");
+
+            Zip::Progress postProgress = nullptr;
+            if (progress) {
+                postProgress = [progress](size_t written, size_t total) {
+                    Loader::get()->queueInMainThread([progress, written, total] {
+                        progress(written, total);
+                    });
+                };
+            }
+            auto entries = collect();
+            Result<> res = Ok();
+            if (entries) {
+                res = this->addBatch(entries.unwrap(), postProgress);
+            }
+            else {
+                res = Err(entries.unwrapErr());
+            }
+
+            // only cleared once `then` runs, so nothing else can touch the 
+            // zip before the callback has seen the result
+            Loader::get()->queueInMainThread([then, res, busy = m_busy] {
+                *busy = false;
+                then(res);
+            });
+        });
+    }
+
+    Result<> ensureIdle() const {
+        if (*m_busy) {
+            return Err("Zip is being written to in the background");
+        }
+        return Ok();
+    }
+
+    bool isBusy() const {
+        return *m_busy;
+    }
+
     ByteVector compressedData() const {
         if (!std::holds_alternative<ByteVector>(m_srcDest)) {
             return ByteVector();
@@ -465,11 +1047,14 @@ public:
         return Path();
     }
 
-    std::unordered_map<Path, ZipEntry> getEntries() const {
+    std::unordered_map<Path, ZipEntry> const& getEntries() const {
         return m_entries;
     }
 
     ~Impl() {
+        if (m_asyncThread.joinable()) {
+            m_asyncThread.join();
+        }
         if (m_handle) {
             mz_zip_close(m_handle);
             mz_zip_delete(&m_handle);
@@ -497,7 +1082,11 @@ Result<Unzip> Unzip::create(Path const& file) {
 }
 
 Result<Unzip> Unzip::create(ByteVector const& data) {
-    GEODE_UNWRAP_INTO(auto impl, Zip::Impl::fromMemory(data));
+    return Unzip::create(ByteVector(data));
+}
+
+Result<Unzip> Unzip::create(ByteVector&& data) {
+    GEODE_UNWRAP_INTO(auto impl, Zip::Impl::fromMemory(std::move(data)));
     return Ok(Unzip(std::move(impl)));
 }
 
@@ -517,6 +1106,10 @@ Result<ByteVector> Unzip::extract(Path const& name) {
     return m_impl->extract(name).expect("{error} (entry {})", name.string());
 }
 
+Result<std::span<uint8_t const>> Unzip::view(Path const& name) const {
+    return m_impl->view(name).expect("{error} (entry {})", name.string());
+}
+
 Result<> Unzip::extractTo(Path const& name, Path const& path) {
     GEODE_UNWRAP_INTO(auto bytes, m_impl->extract(name).expect("{error} (entry {})", name.string()));
     // create containing directories for target path
@@ -577,46 +1170,92 @@ Zip::Path Zip::getPath() const {
 }
 
 ByteVector Zip::getData() const {
+    if (m_impl->isBusy()) {
+        return ByteVector();
+    }
     return m_impl->compressedData();
 }
 
 Result<> Zip::add(Path const& path, ByteVector const& data) {
+    GEODE_UNWRAP(m_impl->ensureIdle());
     return m_impl->add(path, data);
 }
 
+Result<> Zip::add(Path const& path, ByteVector&& data) {
+    GEODE_UNWRAP(m_impl->ensureIdle());
+    return m_impl->add(path, std::move(data));
+}
+
 Result<> Zip::add(Path const& path, std::string const& data) {
     return this->add(path, ByteVector(data.begin(), data.end()));
 }
 
 Result<> Zip::addFrom(Path const& file, Path const& entryDir) {
     GEODE_UNWRAP_INTO(auto data, file::readBinary(file));
-    return this->add(entryDir / file.filename(), data);
-}
-
-Result<> Zip::addAllFromRecurse(Path const& dir, Path const& entry) {
-    GEODE_UNWRAP(this->addFolder(entry / dir.filename()));
-    for (auto& file : ghc::filesystem::directory_iterator(dir)) {
-        if (ghc::filesystem::is_directory(file)) {
-            GEODE_UNWRAP(this->addAllFromRecurse(file, entry / dir.filename()));
-        } else {
-            GEODE_UNWRAP_INTO(auto data, file::readBinary(file));
-            GEODE_UNWRAP(this->addFrom(file, entry / dir.filename()));
-        }
-    }
-    return Ok();
+    return this->add(entryDir / file.filename(), std::move(data));
 }
 
 Result<> Zip::addAllFrom(Path const& dir) {
     if (!ghc::filesystem::is_directory(dir)) {
         return Err("Path is not a directory");
     }
-    return this->addAllFromRecurse(dir, Path());
+    GEODE_UNWRAP(m_impl->ensureIdle());
+    std::vector<ZipBatchEntry> entries;
+    GEODE_UNWRAP(collectAllFrom(dir, Path(), entries));
+    return m_impl->addBatch(entries, nullptr);
 }
 
 Result<> Zip::addFolder(Path const& entry) {
+    GEODE_UNWRAP(m_impl->ensureIdle());
     return m_impl->addFolder(entry);
 }
 
+static std::vector<ZipBatchEntry> toBatch(std::vector<std::pair<Zip::Path, ByteVector>>&& entries) {
+    std::vector<ZipBatchEntry> batch;
+    batch.reserve(entries.size());
+    for (auto& [path, data] : entries) {
+        auto size = data.size();
+        batch.push_back({ .path = std::move(path), .source = std::move(data), .size = size });
+    }
+    return batch;
+}
+
+Result<> Zip::addAll(std::vector<std::pair<Path, ByteVector>> entries) {
+    GEODE_UNWRAP(m_impl->ensureIdle());
+    auto batch = toBatch(std::move(entries));
+    return m_impl->addBatch(batch, nullptr);
+}
+
+void Zip::addAllAsync(
+    std::vector<std::pair<Path, ByteVector>> entries, Finished then, Progress progress
+) {
+    m_impl->addBatchAsync(
+        [batch = toBatch(std::move(entries))]() mutable -> Result<std::vector<ZipBatchEntry>> {
+            return Ok(std::move(batch));
+        },
+        then, progress
+    );
+}
+
+void Zip::addAllFromAsync(Path const& dir, Finished then, Progress progress) {
+    if (!ghc::filesystem::is_directory(dir)) {
+        Loader::get()->queueInMainThread([then] {
+            then(Err("Path is not a directory"));
+        });
+        return;
+    }
+    // walking the directory can take a while too, so it's done on the 
+    // writer thread as well
+    m_impl->addBatchAsync(
+        [dir]() -> Result<std::vector<ZipBatchEntry>> {
+            std::vector<ZipBatchEntry> entries;
+            GEODE_UNWRAP(collectAllFrom(dir, Path(), entries));
+            return Ok(std::move(entries));
+        },
+        then, progress
+    );
+}
+
 FileWatchEvent::FileWatchEvent(ghc::filesystem::path const& path)
   : m_path(path) {}
 
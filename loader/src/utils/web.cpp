@@ -151,6 +151,7 @@ private:
     std::vector<AsyncExpectCode> m_expects;
     std::vector<AsyncProgress> m_progresses;
     std::vector<AsyncCancelled> m_cancelleds;
+    std::vector<AsyncChunk> m_chunks;
     std::unordered_map<std::string, std::string> m_responseHeader;
     Status m_status = Status::Paused;
     std::atomic<bool> m_paused = true;
@@ -170,6 +171,7 @@ private:
     bool m_sent = false;
     std::variant<std::monostate, std::ostream*, ghc::filesystem::path> m_target;
     std::vector<std::string> m_httpHeaders;
+    bool m_resumable = false;
     
 
     template <class T>
@@ -203,6 +205,7 @@ public:
     AsyncExpectCode m_expect = nullptr;
     AsyncProgress m_progress = nullptr;
     AsyncCancelled m_cancelled = nullptr;
+    AsyncChunk m_chunk = nullptr;
     std::string m_userAgent;
     std::string m_customRequest;
     bool m_isPostRequest = false;
@@ -212,6 +215,7 @@ public:
     std::variant<std::monostate, std::ostream*, ghc::filesystem::path> m_target;
     std::vector<std::string> m_httpHeaders;
     std::chrono::seconds m_timeoutSeconds;
+    bool m_resumable = false;
 
     SentAsyncWebRequestHandle send(AsyncWebRequest&);
 };
@@ -230,7 +234,8 @@ SentAsyncWebRequest::Impl::Impl(SentAsyncWebRequest* self, AsyncWebRequest const
     m_postFields(req.m_impl->m_postFields),
     m_isJsonRequest(req.m_impl->m_isJsonRequest),
     m_sent(req.m_impl->m_sent),
-    m_httpHeaders(req.m_impl->m_httpHeaders) {
+    m_httpHeaders(req.m_impl->m_httpHeaders),
+    m_resumable(req.m_impl->m_resumable) {
 
 #define AWAIT_RESUME()    \
     {\
@@ -248,6 +253,7 @@ SentAsyncWebRequest::Impl::Impl(SentAsyncWebRequest* self, AsyncWebRequest const
     if (req.m_impl->m_progress) m_progresses.push_back(req.m_impl->m_progress);
     if (req.m_impl->m_cancelled) m_cancelleds.push_back(req.m_impl->m_cancelled);
     if (req.m_impl->m_expect) m_expects.push_back(req.m_impl->m_expect);
+    if (req.m_impl->m_chunk) m_chunks.push_back(req.m_impl->m_chunk);
 
     auto timeoutSeconds = req.m_impl->m_timeoutSeconds;
 
@@ -267,25 +273,55 @@ SentAsyncWebRequest::Impl::Impl(SentAsyncWebRequest* self, AsyncWebRequest const
         // initialized but don't wanna manually managed memory
         std::unique_ptr<std::ofstream> file = nullptr;
 
+        struct WriteData {
+            SentAsyncWebRequest::Impl* self;
+            std::ostream* stream;
+            ByteVector* bytes;
+        } writeData{this, nullptr, &ret};
+        // size of the partial file being resumed
+        std::uintmax_t resumeFrom = 0;
+
         // into file
         if (std::holds_alternative<ghc::filesystem::path>(m_target)) {
-            file = std::make_unique<std::ofstream>(
-                std::get<ghc::filesystem::path>(m_target), std::ios::out | std::ios::binary
-            );
-            curl_easy_setopt(curl, CURLOPT_WRITEDATA, file.get());
-            curl_easy_setopt(curl, CURLOPT_WRITEFUNCTION, utils::fetch::writeBinaryData);
+            auto& path = std::get<ghc::filesystem::path>(m_target);
+            auto mode = std::ios::out | std::ios::binary;
+            if (m_resumable) {
+                std::error_code ec;
+                auto size = ghc::filesystem::file_size(path, ec);
+                if (!ec && size > 0) {
+                    resumeFrom = size;
+                    mode |= std::ios::app;
+                }
+            }
+            file = std::make_unique<std::ofstream>(path, mode);
+            writeData.stream = file.get();
         }
         // into stream
         else if (std::holds_alternative<std::ostream*>(m_target)) {
-            curl_easy_setopt(curl, CURLOPT_WRITEDATA, std::get<std::ostream*>(m_target));
-            curl_easy_setopt(curl, CURLOPT_WRITEFUNCTION, utils::fetch::writeBinaryData);
-        }
-        // into memory
-        else {
-            curl_easy_setopt(curl, CURLOPT_WRITEDATA, &ret);
-            curl_easy_setopt(curl, CURLOPT_WRITEFUNCTION, utils::fetch::writeBytes);
+            writeData.stream = std::get<std::ostream*>(m_target);
         }
+        // into memory otherwise
+
+        curl_easy_setopt(curl, CURLOPT_WRITEDATA, &writeData);
+        curl_easy_setopt(curl, CURLOPT_WRITEFUNCTION, (+[](char* data, size_t size, size_t nmemb, void* ptr) {
+            auto writeData = static_cast<WriteData*>(ptr);
+            if (writeData->stream) {
+                writeData->stream->write(data, size * nmemb);
+            }
+            else {
+                writeData->bytes->insert(writeData->bytes->end(), data, data + size * nmemb);
+            }
+            std::unique_lock<std::mutex> l(writeData->self->m_mutex);
+            for (auto& chunk : writeData->self->m_chunks) {
+                chunk(data, size * nmemb);
+            }
+            return size * nmemb;
+        }));
         curl_easy_setopt(curl, CURLOPT_URL, m_url.c_str());
+        // Only request the missing part of a partial download
+        if (resumeFrom) {
+            curl_easy_setopt(curl, CURLOPT_RESUME_FROM_LARGE, static_cast<curl_off_t>(resumeFrom));
+        }
         // No need to verify SSL, we trust our domains :-)
         curl_easy_setopt(curl, CURLOPT_SSL_VERIFYPEER, 0);
         curl_easy_setopt(curl, CURLOPT_SSL_VERIFYHOST, 0);
@@ -381,6 +417,18 @@ SentAsyncWebRequest::Impl::Impl(SentAsyncWebRequest* self, AsyncWebRequest const
         );
         curl_easy_setopt(curl, CURLOPT_PROGRESSDATA, &data);
         auto res = curl_easy_perform(curl);
+        // curl fails the transfer before writing anything if the server 
+        // doesn't honor the range (or the partial file no longer fits what 
+        // it has), so download the whole file again
+        if (res == CURLE_RANGE_ERROR && resumeFrom && !m_cancelled) {
+            file->close();
+            file->open(
+                std::get<ghc::filesystem::path>(m_target),
+                std::ios::out | std::ios::binary | std::ios::trunc
+            );
+            curl_easy_setopt(curl, CURLOPT_RESUME_FROM_LARGE, static_cast<curl_off_t>(0));
+            res = curl_easy_perform(curl);
+        }
         long code = 0;
         curl_easy_getinfo(curl, CURLINFO_RESPONSE_CODE, &code);
         if (res != CURLE_OK) {
@@ -399,6 +447,11 @@ SentAsyncWebRequest::Impl::Impl(SentAsyncWebRequest* self, AsyncWebRequest const
         curl_slist_free_all(headers);
         curl_easy_cleanup(curl);
 
+        // make sure the whole file is on disk before anyone reads it
+        if (file) {
+            file->close();
+        }
+
         AWAIT_RESUME();
 
         // if something is still holding a handle to this
@@ -426,8 +479,8 @@ void SentAsyncWebRequest::Impl::doCancel() {
     if (m_cleanedUp) return;
     m_cleanedUp = true;
 
-    // remove file if downloaded to one
-    if (std::holds_alternative<ghc::filesystem::path>(m_target)) {
+    // remove file if downloaded to one, unless it's meant to be resumed
+    if (std::holds_alternative<ghc::filesystem::path>(m_target) && !m_resumable) {
         auto path = std::get<ghc::filesystem::path>(m_target);
         if (ghc::filesystem::exists(path)) {
             std::error_code ec;
@@ -635,6 +688,16 @@ AsyncWebRequest& AsyncWebRequest::cancelled(AsyncCancelled cancelledFunc) {
     return *this;
 }
 
+AsyncWebRequest& AsyncWebRequest::chunk(AsyncChunk chunkFunc) {
+    m_impl->m_chunk = chunkFunc;
+    return *this;
+}
+
+AsyncWebRequest& AsyncWebRequest::resumable(bool resumable) {
+    m_impl->m_resumable = resumable;
+    return *this;
+}
+
 SentAsyncWebRequestHandle AsyncWebRequest::send() {
     return m_impl->send(*this);
 }
@@ -660,6 +723,7 @@ SentAsyncWebRequestHandle AsyncWebRequest::Impl::send(AsyncWebRequest& reqObj) {
         if (m_progress) req->m_impl->m_progresses.push_back(m_progress);
         if (m_expect) req->m_impl->m_expects.push_back(m_expect);
         if (m_cancelled) req->m_impl->m_cancelleds.push_back(m_cancelled);
+        if (m_chunk) req->m_impl->m_chunks.push_back(m_chunk);
         ret = req;
     }
     else {